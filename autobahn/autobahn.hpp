@@ -19,10 +19,14 @@
 #ifndef AUTOBAHN_HPP
 #define AUTOBAHN_HPP
 
+#include "wamp_argument_pack.hpp"
 #include "wamp_event.hpp"
 #include "wamp_invocation.hpp"
+#include "wamp_kw_view.hpp"
 #include "wamp_session.hpp"
 #include "wamp_tcp_client.hpp"
+#include "wamp_runtime.hpp"
+#include "wamp_session_pool.hpp"
 
 /*! \mainpage Reference Documentation
  *
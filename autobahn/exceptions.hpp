@@ -31,6 +31,11 @@ class no_session_error : public std::runtime_error {
      no_session_error() : std::runtime_error("session not joined") {};
 };
 
+class timeout_error : public std::runtime_error {
+  public:
+     timeout_error(const std::string& message) : std::runtime_error(message) {};
+};
+
 } // namespace autobahn
 
 #endif // AUTOBAHN_EXCEPTIONS_HPP
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_ARGUMENT_PACK_HPP
+#define AUTOBAHN_WAMP_ARGUMENT_PACK_HPP
+
+#include <cstddef>
+#include <msgpack.hpp>
+#include <tuple>
+
+namespace autobahn {
+
+/*!
+ * Positional arguments packed straight from the caller's variables, without
+ * building a container first. Create them with wamp_args().
+ *
+ * The pack only refers to the arguments, so it must not outlive the
+ * expression it was created in.
+ */
+template <typename... T>
+class wamp_argument_pack
+{
+public:
+    explicit wamp_argument_pack(const T&... arguments);
+
+    const std::tuple<const T&...>& arguments() const;
+
+private:
+    std::tuple<const T&...> m_arguments;
+};
+
+/*!
+ * Keyword arguments packed straight from alternating keys and values, without
+ * building a map first. Create them with wamp_kw_args().
+ *
+ * The pack only refers to the keys and values, so it must not outlive the
+ * expression it was created in.
+ */
+template <typename... T>
+class wamp_kw_argument_pack
+{
+public:
+    static_assert(sizeof...(T) % 2 == 0, "keyword arguments must alternate keys and values");
+
+    explicit wamp_kw_argument_pack(const T&... keys_and_values);
+
+    const std::tuple<const T&...>& keys_and_values() const;
+
+private:
+    std::tuple<const T&...> m_keys_and_values;
+};
+
+/*!
+ * Positional arguments for a call, publish, result or error, packed in place.
+ *
+ * Example:
+ * `session->call("com.example.add", autobahn::wamp_args(a, b));`
+ */
+template <typename... T>
+wamp_argument_pack<T...> wamp_args(const T&... arguments);
+
+/*!
+ * Keyword arguments for a call, publish, result or error, packed in place from
+ * alternating keys and values.
+ *
+ * Example:
+ * `invocation->result(autobahn::wamp_args(), autobahn::wamp_kw_args("id", id, "name", name));`
+ */
+template <typename... T>
+wamp_kw_argument_pack<T...> wamp_kw_args(const T&... keys_and_values);
+
+} // namespace autobahn
+
+namespace msgpack {
+MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) {
+namespace adaptor {
+
+template <typename... T>
+struct pack<autobahn::wamp_argument_pack<T...>>
+{
+    template <typename Stream>
+    msgpack::packer<Stream>& operator()(
+            msgpack::packer<Stream>& packer, const autobahn::wamp_argument_pack<T...>& arguments) const;
+};
+
+template <typename... T>
+struct pack<autobahn::wamp_kw_argument_pack<T...>>
+{
+    template <typename Stream>
+    msgpack::packer<Stream>& operator()(
+            msgpack::packer<Stream>& packer, const autobahn::wamp_kw_argument_pack<T...>& kw_arguments) const;
+};
+
+} // namespace adaptor
+} // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
+} // namespace msgpack
+
+#include "wamp_argument_pack.ipp"
+
+#endif // AUTOBAHN_WAMP_ARGUMENT_PACK_HPP
@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+
+namespace autobahn {
+
+namespace detail {
+
+/// Packs the elements I to N - 1 of a tuple one after another.
+template <std::size_t I, std::size_t N>
+struct pack_elements
+{
+    template <typename Stream, typename Tuple>
+    static void pack(msgpack::packer<Stream>& packer, const Tuple& elements)
+    {
+        packer.pack(std::get<I>(elements));
+        pack_elements<I + 1, N>::pack(packer, elements);
+    }
+};
+
+template <std::size_t N>
+struct pack_elements<N, N>
+{
+    template <typename Stream, typename Tuple>
+    static void pack(msgpack::packer<Stream>&, const Tuple&)
+    {
+    }
+};
+
+} // namespace detail
+
+template <typename... T>
+inline wamp_argument_pack<T...>::wamp_argument_pack(const T&... arguments)
+    : m_arguments(arguments...)
+{
+}
+
+template <typename... T>
+inline const std::tuple<const T&...>& wamp_argument_pack<T...>::arguments() const
+{
+    return m_arguments;
+}
+
+template <typename... T>
+inline wamp_kw_argument_pack<T...>::wamp_kw_argument_pack(const T&... keys_and_values)
+    : m_keys_and_values(keys_and_values...)
+{
+}
+
+template <typename... T>
+inline const std::tuple<const T&...>& wamp_kw_argument_pack<T...>::keys_and_values() const
+{
+    return m_keys_and_values;
+}
+
+template <typename... T>
+inline wamp_argument_pack<T...> wamp_args(const T&... arguments)
+{
+    return wamp_argument_pack<T...>(arguments...);
+}
+
+template <typename... T>
+inline wamp_kw_argument_pack<T...> wamp_kw_args(const T&... keys_and_values)
+{
+    return wamp_kw_argument_pack<T...>(keys_and_values...);
+}
+
+} // namespace autobahn
+
+namespace msgpack {
+MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) {
+namespace adaptor {
+
+template <typename... T>
+template <typename Stream>
+msgpack::packer<Stream>& pack<autobahn::wamp_argument_pack<T...>>::operator()(
+        msgpack::packer<Stream>& packer, const autobahn::wamp_argument_pack<T...>& arguments) const
+{
+    packer.pack_array(static_cast<uint32_t>(sizeof...(T)));
+    autobahn::detail::pack_elements<0, sizeof...(T)>::pack(packer, arguments.arguments());
+
+    return packer;
+}
+
+template <typename... T>
+template <typename Stream>
+msgpack::packer<Stream>& pack<autobahn::wamp_kw_argument_pack<T...>>::operator()(
+        msgpack::packer<Stream>& packer, const autobahn::wamp_kw_argument_pack<T...>& kw_arguments) const
+{
+    // Keys and values alternate, so packing them in order yields the map entries.
+    packer.pack_map(static_cast<uint32_t>(sizeof...(T) / 2));
+    autobahn::detail::pack_elements<0, sizeof...(T)>::pack(packer, kw_arguments.keys_and_values());
+
+    return packer;
+}
+
+} // namespace adaptor
+} // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
+} // namespace msgpack
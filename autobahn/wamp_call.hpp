@@ -20,6 +20,7 @@
 #define AUTOBAHN_WAMP_CALL_HPP
 
 #include "wamp_call_result.hpp"
+#include "wamp_progress_handler.hpp"
 
 // http://stackoverflow.com/questions/22597948/using-boostfuture-with-then-continuations/
 #define BOOST_THREAD_PROVIDES_FUTURE
@@ -27,6 +28,7 @@
 #define BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
 #include <boost/thread/future.hpp>
 
+#include <cstdint>
 #include <msgpack.hpp>
 
 namespace autobahn {
@@ -40,8 +42,19 @@ public:
     boost::promise<wamp_call_result>& result();
     void set_result(wamp_call_result&& value);
 
+    /// The handler for progressive results, empty if none were requested.
+    const wamp_progress_handler& progress_handler() const;
+    void set_progress_handler(const wamp_progress_handler& handler);
+
+    /// The tick of the session's call timeout wheel at which the call times out,
+    /// zero if it has no timeout.
+    uint64_t timeout_tick() const;
+    void set_timeout_tick(uint64_t tick);
+
 private:
     boost::promise<wamp_call_result> m_result;
+    wamp_progress_handler m_progress_handler;
+    uint64_t m_timeout_tick;
 };
 
 } // namespace autobahn
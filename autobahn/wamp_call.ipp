@@ -20,6 +20,8 @@ namespace autobahn {
 
 inline wamp_call::wamp_call()
     : m_result()
+    , m_progress_handler()
+    , m_timeout_tick(0)
 {
 }
 
@@ -33,4 +35,24 @@ inline void wamp_call::set_result(wamp_call_result&& value)
     m_result.set_value(std::move(value));
 }
 
+inline const wamp_progress_handler& wamp_call::progress_handler() const
+{
+    return m_progress_handler;
+}
+
+inline void wamp_call::set_progress_handler(const wamp_progress_handler& handler)
+{
+    m_progress_handler = handler;
+}
+
+inline uint64_t wamp_call::timeout_tick() const
+{
+    return m_timeout_tick;
+}
+
+inline void wamp_call::set_timeout_tick(uint64_t tick)
+{
+    m_timeout_tick = tick;
+}
+
 } // namespace autobahn
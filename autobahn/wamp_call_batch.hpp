@@ -0,0 +1,115 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_CALL_BATCH_HPP
+#define AUTOBAHN_WAMP_CALL_BATCH_HPP
+
+#include "wamp_call_options.hpp"
+#include "wamp_call_result.hpp"
+#include "wamp_frames.hpp"
+
+// http://stackoverflow.com/questions/22597948/using-boostfuture-with-then-continuations/
+#define BOOST_THREAD_PROVIDES_FUTURE
+#define BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+#define BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+#include <boost/thread/future.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <msgpack.hpp>
+#include <string>
+#include <vector>
+
+namespace autobahn {
+
+/// Results of the calls of a batch, in the order the calls were added to it.
+typedef boost::csbl::vector<boost::future<wamp_call_result>> wamp_call_batch_results;
+
+/*!
+ * A batch of remote procedure calls that a session issues with a single write.
+ *
+ * The CALL messages are serialized as they are added; request IDs are filled
+ * in by wamp_session::call_many() when issuing the batch. Options are sent as
+ * given, the session's default call timeout is only applied locally.
+ */
+class wamp_call_batch
+{
+public:
+    wamp_call_batch();
+
+    /*!
+     * Add a call with no arguments.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param options Options for the call.
+     */
+    void call(const std::string& procedure,
+            const wamp_call_options& options = wamp_call_options());
+
+    /*!
+     * Add a call with positional arguments.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param arguments The positional arguments for the call.
+     * \param options Options for the call.
+     */
+    template <typename List>
+    void call(const std::string& procedure, const List& arguments,
+            const wamp_call_options& options = wamp_call_options());
+
+    /*!
+     * Add a call with positional and keyword arguments.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param arguments The positional arguments for the call.
+     * \param kw_arguments The keyword arguments for the call.
+     * \param options Options for the call.
+     */
+    template <typename List, typename Map>
+    void call(const std::string& procedure, const List& arguments, const Map& kw_arguments,
+            const wamp_call_options& options = wamp_call_options());
+
+    /*!
+     * The number of calls in the batch.
+     */
+    std::size_t size() const;
+
+    bool empty() const;
+
+    //
+    // functions only called internally by wamp_session
+
+    wamp_frames& frames();
+
+    /// The options of the calls, in the order the calls were added.
+    const std::vector<wamp_call_options>& options() const;
+
+private:
+    /// Pack the header of a CALL message up to and including the procedure.
+    void pack_header(msgpack::packer<msgpack::sbuffer>& packer, uint32_t length,
+            const std::string& procedure, const wamp_call_options& options);
+
+    wamp_frames m_frames;
+    std::vector<wamp_call_options> m_options;
+};
+
+} // namespace autobahn
+
+#include "wamp_call_batch.ipp"
+
+#endif // AUTOBAHN_WAMP_CALL_BATCH_HPP
@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "wamp_message_type.hpp"
+
+namespace autobahn {
+
+inline wamp_call_batch::wamp_call_batch()
+    : m_frames()
+    , m_options()
+{
+}
+
+inline void wamp_call_batch::call(const std::string& procedure, const wamp_call_options& options)
+{
+    msgpack::packer<msgpack::sbuffer> packer(m_frames.buffer());
+
+    // [CALL, Request|id, Options|dict, Procedure|uri]
+    m_frames.begin_frame();
+    pack_header(packer, 4, procedure, options);
+    m_frames.end_frame();
+}
+
+template <typename List>
+inline void wamp_call_batch::call(
+        const std::string& procedure, const List& arguments, const wamp_call_options& options)
+{
+    msgpack::packer<msgpack::sbuffer> packer(m_frames.buffer());
+
+    // [CALL, Request|id, Options|dict, Procedure|uri, Arguments|list]
+    m_frames.begin_frame();
+    pack_header(packer, 5, procedure, options);
+    packer.pack(arguments);
+    m_frames.end_frame();
+}
+
+template <typename List, typename Map>
+inline void wamp_call_batch::call(
+        const std::string& procedure, const List& arguments, const Map& kw_arguments,
+        const wamp_call_options& options)
+{
+    msgpack::packer<msgpack::sbuffer> packer(m_frames.buffer());
+
+    // [CALL, Request|id, Options|dict, Procedure|uri, Arguments|list, ArgumentsKw|dict]
+    m_frames.begin_frame();
+    pack_header(packer, 6, procedure, options);
+    packer.pack(arguments);
+    packer.pack(kw_arguments);
+    m_frames.end_frame();
+}
+
+inline std::size_t wamp_call_batch::size() const
+{
+    return m_frames.size();
+}
+
+inline bool wamp_call_batch::empty() const
+{
+    return m_frames.empty();
+}
+
+inline wamp_frames& wamp_call_batch::frames()
+{
+    return m_frames;
+}
+
+inline const std::vector<wamp_call_options>& wamp_call_batch::options() const
+{
+    return m_options;
+}
+
+inline void wamp_call_batch::pack_header(
+        msgpack::packer<msgpack::sbuffer>& packer, uint32_t length,
+        const std::string& procedure, const wamp_call_options& options)
+{
+    packer.pack_array(length);
+    packer.pack(static_cast<int>(message_type::CALL));
+    m_frames.pack_request_id(packer);
+    packer.pack(options);
+    packer.pack(procedure);
+
+    m_options.push_back(options);
+}
+
+} // namespace autobahn
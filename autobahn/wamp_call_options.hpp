@@ -0,0 +1,88 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_CALL_OPTIONS_HPP
+#define AUTOBAHN_WAMP_CALL_OPTIONS_HPP
+
+#include "wamp_progress_handler.hpp"
+
+#include <chrono>
+#include <msgpack.hpp>
+
+namespace autobahn {
+
+/*!
+ * Options for a single remote procedure call.
+ *
+ * The options are sent to the dealer as CALL.Options, so a dealer supporting
+ * call timeouts enforces them as well.
+ */
+class wamp_call_options
+{
+public:
+    wamp_call_options();
+
+    /*!
+     * How long to wait for the result before canceling the call, zero to use
+     * the session's default call timeout (the default).
+     */
+    const std::chrono::milliseconds& timeout() const;
+
+    /*!
+     * Whether progressive results were requested, i.e. a progress handler is set.
+     */
+    bool receive_progress() const;
+
+    const wamp_progress_handler& progress_handler() const;
+
+    void set_timeout(const std::chrono::milliseconds& timeout);
+
+    /*!
+     * Request progressive results for the call. Each progressive RESULT is
+     * passed to @p handler on the session's io thread as it arrives, and its
+     * memory is released once the handler returns; the call's future resolves
+     * with the final result.
+     */
+    void set_progress_handler(const wamp_progress_handler& handler);
+
+private:
+    std::chrono::milliseconds m_timeout;
+    wamp_progress_handler m_progress_handler;
+};
+
+} // namespace autobahn
+
+namespace msgpack {
+MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) {
+namespace adaptor {
+
+template<>
+struct pack<autobahn::wamp_call_options>
+{
+    template <typename Stream>
+    msgpack::packer<Stream>& operator()(
+            msgpack::packer<Stream>& packer, const autobahn::wamp_call_options& options) const;
+};
+
+} // namespace adaptor
+} // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
+} // namespace msgpack
+
+#include "wamp_call_options.ipp"
+
+#endif // AUTOBAHN_WAMP_CALL_OPTIONS_HPP
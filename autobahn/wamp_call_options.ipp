@@ -0,0 +1,83 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstdint>
+#include <string>
+
+namespace autobahn {
+
+inline wamp_call_options::wamp_call_options()
+    : m_timeout(0)
+    , m_progress_handler()
+{
+}
+
+inline const std::chrono::milliseconds& wamp_call_options::timeout() const
+{
+    return m_timeout;
+}
+
+inline bool wamp_call_options::receive_progress() const
+{
+    return static_cast<bool>(m_progress_handler);
+}
+
+inline const wamp_progress_handler& wamp_call_options::progress_handler() const
+{
+    return m_progress_handler;
+}
+
+inline void wamp_call_options::set_timeout(const std::chrono::milliseconds& timeout)
+{
+    m_timeout = timeout;
+}
+
+inline void wamp_call_options::set_progress_handler(const wamp_progress_handler& handler)
+{
+    m_progress_handler = handler;
+}
+
+} // namespace autobahn
+
+namespace msgpack {
+MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) {
+namespace adaptor {
+
+template <typename Stream>
+msgpack::packer<Stream>& pack<autobahn::wamp_call_options>::operator()(
+        msgpack::packer<Stream>& packer, const autobahn::wamp_call_options& options) const
+{
+    bool timeout = options.timeout().count() > 0;
+    packer.pack_map((timeout ? 1 : 0) + (options.receive_progress() ? 1 : 0));
+
+    if (timeout) {
+        packer.pack(std::string("timeout"));
+        packer.pack(static_cast<uint64_t>(options.timeout().count()));
+    }
+
+    if (options.receive_progress()) {
+        packer.pack(std::string("receive_progress"));
+        packer.pack(true);
+    }
+
+    return packer;
+}
+
+} // namespace adaptor
+} // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
+} // namespace msgpack
@@ -19,16 +19,30 @@
 #ifndef AUTOBAHN_WAMP_CALL_RESULT_HPP
 #define AUTOBAHN_WAMP_CALL_RESULT_HPP
 
+#include "wamp_kw_index.hpp"
+#include "wamp_lazy_payload.hpp"
+#include "wamp_raw_payload.hpp"
+#include "wamp_typed_array.hpp"
+
+#include <memory>
 #include <msgpack.hpp>
 #include <string>
 
 namespace autobahn {
 
+/*!
+ * The result of a call.
+ *
+ * A result shares ownership of the zone its payload was unpacked into and never
+ * modifies the payload, so copying a result (e.g. through boost::shared_future::get()
+ * or a lambda capture) only bumps a reference count instead of copying the payload.
+ */
 class wamp_call_result
 {
 public:
     wamp_call_result();
     wamp_call_result(msgpack::unique_ptr<msgpack::zone>&& zone);
+    wamp_call_result(const std::shared_ptr<msgpack::zone>& zone);
     wamp_call_result(const wamp_call_result& other);
     wamp_call_result(wamp_call_result&& other);
 
@@ -57,6 +71,20 @@ public:
     template <typename T>
     T argument(std::size_t index) const;
 
+    /*!
+     * The positional argument returned from the call with the given @p index, read as a typed
+     * numeric array (see wamp_typed_array) without copying its elements. The view
+     * is valid as long as the call result is.
+     *
+     * Example:
+     * `auto samples = result.typed_array_argument<float>(0);`
+     *
+     * @throw std::out_of_range
+     * @throw msgpack::type_error if the argument is not a typed array of T
+     */
+    template <typename T>
+    wamp_typed_array_view<T> typed_array_argument(std::size_t index) const;
+
     /*!
      * The positional arguments returned from the call, converted to a list type.
      *
@@ -104,13 +132,11 @@ public:
     /*!
      * The keyword argument returned from the call with the given @p key, converted to type T.
      *
-     * Overloads are provided for `std::string` and `char*` as @p key type.
+     * Overloads are provided for `std::string`, `char*` and autobahn::wamp_kw_key as @p key type.
      *
-     * This function uses key string comparisons to find the matching value, O(n) with n being
-     * the number of map elements. Memory allocation for keys is avoided though. For larger maps,
-     * you might want to prioritize look-up performance by using `std::map`, `std::unordered_map`
-     * or custom types with custom deserialization. To do this, use kw_arguments<Map>() or
-     * get_kw_arguments<Map>(map), then access the items from there.
+     * Small maps are searched by comparing key strings, without allocating memory. Maps with
+     * more than wamp_kw_lookup::INDEX_THRESHOLD entries get a hash index with the first look-up,
+     * which makes further look-ups O(1). A wamp_kw_key hashes its key once for all look-ups.
      *
      * Example:
      * `std::string id = result.kw_argument<std::string>("id");`
@@ -124,17 +150,18 @@ public:
     template <typename T>
     T kw_argument(const char* key) const;
 
+    template <typename T>
+    T kw_argument(const wamp_kw_key& key) const;
+
     /*!
      * The keyword argument returned from the call with the given @p key, converted to type T,
      * or the given @p fallback if no such key was passed.
      *
-     * Overloads are provided for `std::string` and `char*` as @p key type.
+     * Overloads are provided for `std::string`, `char*` and autobahn::wamp_kw_key as @p key type.
      *
-     * This function uses key string comparisons to find the matching value, O(n) with n being
-     * the number of map elements. Memory allocation for keys is avoided though. For larger maps,
-     * you might want to prioritize look-up performance by using `std::map`, `std::unordered_map`
-     * or custom types with custom deserialization. To do this, use kw_arguments<Map>() or
-     * get_kw_arguments<Map>(map), then access the items from there.
+     * Small maps are searched by comparing key strings, without allocating memory. Maps with
+     * more than wamp_kw_lookup::INDEX_THRESHOLD entries get a hash index with the first look-up,
+     * which makes further look-ups O(1). A wamp_kw_key hashes its key once for all look-ups.
      *
      * Example:
      * `std::string id = result.kw_argument_or("id", std::string());`
@@ -147,6 +174,9 @@ public:
     template <typename T>
     T kw_argument_or(const char* key, const T& fallback) const;
 
+    template <typename T>
+    T kw_argument_or(const wamp_kw_key& key, const T& fallback) const;
+
     /*!
      * The keyword arguments returned from the call, converted to a map type.
      *
@@ -172,16 +202,43 @@ public:
     template <typename Map>
     void get_kw_arguments(Map& kw_args) const;
 
+    /*!
+     * The encoded positional arguments returned from the call, for passing them on with
+     * publish_raw(), call_raw() or result_raw() without decoding them.
+     *
+     * With lazy payloads (see wamp_session::set_lazy_payloads()) these are the
+     * bytes as received; otherwise the decoded arguments are encoded again with
+     * the first call. The span is empty if there are no arguments and valid as
+     * long as the call result is.
+     */
+    wamp_msgpack_span raw_arguments() const;
+
+    /*!
+     * The encoded keyword arguments returned from the call, see raw_arguments().
+     */
+    wamp_msgpack_span raw_kw_arguments() const;
+
     //
     // functions only called internally by wamp_session
 
     void set_arguments(const msgpack::object& arguments);
     void set_kw_arguments(const msgpack::object& kw_arguments);
+    void set_lazy_payload(const std::shared_ptr<wamp_lazy_payload>& payload);
 
 private:
+    /// The arguments, decoded from the lazy payload if there is one.
+    const msgpack::object& arguments_object() const;
+    const msgpack::object& kw_arguments_object() const;
+
     msgpack::object m_arguments;
     msgpack::object m_kw_arguments;
-    msgpack::unique_ptr<msgpack::zone> m_zone;
+    wamp_kw_lookup m_kw_lookup;
+    wamp_raw_encoding m_raw_arguments;
+    wamp_raw_encoding m_raw_kw_arguments;
+    std::shared_ptr<msgpack::zone> m_zone;
+
+    /// The encoded payload of a result received in lazy mode.
+    std::shared_ptr<wamp_lazy_payload> m_lazy_payload;
 };
 
 } // namespace autobahn
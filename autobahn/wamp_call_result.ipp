@@ -36,20 +36,38 @@ inline wamp_call_result::wamp_call_result(msgpack::unique_ptr<msgpack::zone>&& z
 {
 }
 
+inline wamp_call_result::wamp_call_result(const std::shared_ptr<msgpack::zone>& zone)
+    : m_arguments(EMPTY_ARGUMENTS)
+    , m_kw_arguments(EMPTY_KW_ARGUMENTS)
+    , m_zone(zone)
+{
+}
+
 inline wamp_call_result::wamp_call_result(const wamp_call_result& other)
+    : m_arguments(other.m_arguments)
+    , m_kw_arguments(other.m_kw_arguments)
+    , m_kw_lookup(other.m_kw_lookup)
+    , m_raw_arguments(other.m_raw_arguments)
+    , m_raw_kw_arguments(other.m_raw_kw_arguments)
+    , m_zone(other.m_zone)
+    , m_lazy_payload(other.m_lazy_payload)
 {
-    m_zone.reset(new msgpack::zone());
-    m_arguments = msgpack::object(other.m_arguments, m_zone.get());
-    m_kw_arguments = msgpack::object(other.m_kw_arguments, m_zone.get());
 }
 
 inline wamp_call_result::wamp_call_result(wamp_call_result&& other)
     : m_arguments(other.m_arguments)
     , m_kw_arguments(other.m_kw_arguments)
+    , m_kw_lookup(other.m_kw_lookup)
+    , m_raw_arguments(other.m_raw_arguments)
+    , m_raw_kw_arguments(other.m_raw_kw_arguments)
     , m_zone(std::move(other.m_zone))
+    , m_lazy_payload(std::move(other.m_lazy_payload))
 {
     other.m_arguments = EMPTY_ARGUMENTS;
     other.m_kw_arguments = EMPTY_KW_ARGUMENTS;
+    other.m_kw_lookup.reset();
+    other.m_raw_arguments.reset();
+    other.m_raw_kw_arguments.reset();
 }
 
 inline wamp_call_result& wamp_call_result::operator=(const wamp_call_result& other)
@@ -58,9 +76,13 @@ inline wamp_call_result& wamp_call_result::operator=(const wamp_call_result& oth
         return *this;
     }
 
-    m_zone.reset(new msgpack::zone());
-    m_arguments = msgpack::object(other.m_arguments, m_zone.get());
-    m_kw_arguments = msgpack::object(other.m_kw_arguments, m_zone.get());
+    m_arguments = other.m_arguments;
+    m_kw_arguments = other.m_kw_arguments;
+    m_kw_lookup = other.m_kw_lookup;
+    m_raw_arguments = other.m_raw_arguments;
+    m_raw_kw_arguments = other.m_raw_kw_arguments;
+    m_zone = other.m_zone;
+    m_lazy_payload = other.m_lazy_payload;
 
     return *this;
 }
@@ -73,142 +95,172 @@ inline wamp_call_result& wamp_call_result::operator=(wamp_call_result&& other)
 
     m_arguments = other.m_arguments;
     m_kw_arguments = other.m_kw_arguments;
+    m_kw_lookup = other.m_kw_lookup;
+    m_raw_arguments = other.m_raw_arguments;
+    m_raw_kw_arguments = other.m_raw_kw_arguments;
     m_zone = std::move(other.m_zone);
+    m_lazy_payload = std::move(other.m_lazy_payload);
 
     other.m_arguments = EMPTY_ARGUMENTS;
     other.m_kw_arguments = EMPTY_KW_ARGUMENTS;
+    other.m_kw_lookup.reset();
+    other.m_raw_arguments.reset();
+    other.m_raw_kw_arguments.reset();
 
     return *this;
 }
 
 inline std::size_t wamp_call_result::number_of_arguments() const
 {
+    if (m_lazy_payload) {
+        return m_lazy_payload->number_of_arguments();
+    }
     return m_arguments.type == msgpack::type::ARRAY ? m_arguments.via.array.size : 0;
 }
 
 inline std::size_t wamp_call_result::number_of_kw_arguments() const
 {
+    if (m_lazy_payload) {
+        return m_lazy_payload->number_of_kw_arguments();
+    }
     return m_kw_arguments.type == msgpack::type::MAP ? m_kw_arguments.via.map.size : 0;
 }
 
 template <typename T>
 inline T wamp_call_result::argument(std::size_t index) const
 {
+    if (m_lazy_payload) {
+        return m_lazy_payload->argument(index).as<T>();
+    }
     if (m_arguments.type != msgpack::type::ARRAY || m_arguments.via.array.size <= index) {
         throw std::out_of_range("no argument at index " + boost::lexical_cast<std::string>(index));
     }
     return m_arguments.via.array.ptr[index].as<T>();
 }
 
+template <typename T>
+inline wamp_typed_array_view<T> wamp_call_result::typed_array_argument(std::size_t index) const
+{
+    return argument<wamp_typed_array_view<T>>(index);
+}
+
 template <typename List>
 inline List wamp_call_result::arguments() const
 {
-    return m_arguments.as<List>();
+    return arguments_object().as<List>();
 }
 
 template <typename List>
 inline void wamp_call_result::get_arguments(List& args) const
 {
-    m_arguments.convert(args);
+    arguments_object().convert(args);
 }
 
 template <typename... T>
 inline void wamp_call_result::get_each_argument(T&... args) const
 {
     auto args_tuple = std::make_tuple(std::ref(args)...);
-    m_arguments.convert(args_tuple);
+    arguments_object().convert(args_tuple);
 }
 
 template <typename T>
 inline T wamp_call_result::kw_argument(const std::string& key) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key.size() == kv.key.via.str.size
-                && key.compare(0, key.size(), kv.key.via.str.ptr, kv.key.via.str.size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    throw std::out_of_range(key + " keyword argument doesn't exist");
+    return detail::require_kw_argument(
+            m_lazy_payload, m_kw_lookup, m_kw_arguments, key.data(), key.size()).as<T>();
 }
 
 template <typename T>
 inline T wamp_call_result::kw_argument(const char* key) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    std::size_t key_size = strlen(key);
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key_size == kv.key.via.str.size
-                && memcmp(key, kv.key.via.str.ptr, key_size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    throw std::out_of_range(std::string(key) + " keyword argument doesn't exist");
+    return detail::require_kw_argument(
+            m_lazy_payload, m_kw_lookup, m_kw_arguments, key, strlen(key)).as<T>();
 }
 
 template <typename T>
 inline T wamp_call_result::kw_argument_or(const std::string& key, const T& fallback) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key.size() == kv.key.via.str.size
-                && key.compare(0, key.size(), kv.key.via.str.ptr, kv.key.via.str.size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    return fallback;
+    const msgpack::object* value = detail::find_kw_argument(
+            m_lazy_payload, m_kw_lookup, m_kw_arguments, key.data(), key.size());
+    return value ? value->as<T>() : fallback;
 }
 
 template <typename T>
 inline T wamp_call_result::kw_argument_or(const char* key, const T& fallback) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    std::size_t key_size = strlen(key);
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key_size == kv.key.via.str.size
-                && memcmp(key, kv.key.via.str.ptr, key_size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    throw fallback;
+    const msgpack::object* value = detail::find_kw_argument(
+            m_lazy_payload, m_kw_lookup, m_kw_arguments, key, strlen(key));
+    return value ? value->as<T>() : fallback;
+}
+
+template <typename T>
+inline T wamp_call_result::kw_argument(const wamp_kw_key& key) const
+{
+    return detail::require_kw_argument(m_lazy_payload, m_kw_lookup, m_kw_arguments, key).as<T>();
+}
+
+template <typename T>
+inline T wamp_call_result::kw_argument_or(const wamp_kw_key& key, const T& fallback) const
+{
+    const msgpack::object* value = detail::find_kw_argument(
+            m_lazy_payload, m_kw_lookup, m_kw_arguments, key);
+    return value ? value->as<T>() : fallback;
 }
 
 template <typename Map>
 inline Map wamp_call_result::kw_arguments() const
 {
-    return m_kw_arguments.as<Map>();
+    return kw_arguments_object().as<Map>();
 }
 
 template <typename Map>
 inline void wamp_call_result::get_kw_arguments(Map& kw_args) const
 {
-    m_kw_arguments.convert(kw_args);
+    kw_arguments_object().convert(kw_args);
+}
+
+inline wamp_msgpack_span wamp_call_result::raw_arguments() const
+{
+    if (m_lazy_payload) {
+        return m_lazy_payload->raw_arguments();
+    }
+    return m_raw_arguments.span(m_arguments);
+}
+
+inline wamp_msgpack_span wamp_call_result::raw_kw_arguments() const
+{
+    if (m_lazy_payload) {
+        return m_lazy_payload->raw_kw_arguments();
+    }
+    return m_raw_kw_arguments.span(m_kw_arguments);
 }
 
 inline void wamp_call_result::set_arguments(const msgpack::object& arguments)
 {
     m_arguments = arguments;
+    m_raw_arguments.reset();
 }
 
 inline void wamp_call_result::set_kw_arguments(const msgpack::object& kw_arguments)
 {
     m_kw_arguments = kw_arguments;
+    m_kw_lookup.reset();
+    m_raw_kw_arguments.reset();
+}
+
+inline void wamp_call_result::set_lazy_payload(const std::shared_ptr<wamp_lazy_payload>& payload)
+{
+    m_lazy_payload = payload;
+}
+
+inline const msgpack::object& wamp_call_result::arguments_object() const
+{
+    return m_lazy_payload ? m_lazy_payload->arguments() : m_arguments;
+}
+
+inline const msgpack::object& wamp_call_result::kw_arguments_object() const
+{
+    return m_lazy_payload ? m_lazy_payload->kw_arguments() : m_kw_arguments;
 }
 
 } // namespace autobahn
@@ -20,16 +20,30 @@
 #define AUTOBAHN_WAMP_EVENT_HPP
 
 #include "wamp_arguments.hpp"
+#include "wamp_kw_index.hpp"
+#include "wamp_lazy_payload.hpp"
+#include "wamp_raw_payload.hpp"
+#include "wamp_typed_array.hpp"
 
+#include <memory>
 #include <msgpack.hpp>
 #include <string>
 
 namespace autobahn {
 
+/*!
+ * An event received under a subscription.
+ *
+ * Events delivered by the session share ownership of the zone their payload was
+ * unpacked into, so an event (and any msgpack::object taken from it) stays valid
+ * for as long as a copy of the event exists. Copying an event does not copy the
+ * payload.
+ */
 class wamp_event
 {
 public:
     wamp_event();
+    wamp_event(const std::shared_ptr<msgpack::zone>& zone);
 
     /*!
      * The number of positional arguments published by the event.
@@ -53,6 +67,20 @@ public:
     template <typename T>
     T argument(std::size_t index) const;
 
+    /*!
+     * The positional argument published by the event with the given @p index, read as a typed
+     * numeric array (see wamp_typed_array) without copying its elements. The view
+     * is valid as long as the event is.
+     *
+     * Example:
+     * `auto samples = event.typed_array_argument<float>(0);`
+     *
+     * @throw std::out_of_range
+     * @throw msgpack::type_error if the argument is not a typed array of T
+     */
+    template <typename T>
+    wamp_typed_array_view<T> typed_array_argument(std::size_t index) const;
+
     /*!
      * The positional arguments published by the event, converted to a list type.
      *
@@ -100,13 +128,11 @@ public:
     /*!
      * The keyword argument published by the event with the given @p key, converted to type T.
      *
-     * Overloads are provided for `std::string` and `char*` as @p key type.
+     * Overloads are provided for `std::string`, `char*` and autobahn::wamp_kw_key as @p key type.
      *
-     * This function uses key string comparisons to find the matching value, O(n) with n being
-     * the number of map elements. Memory allocation for keys is avoided though. For larger maps,
-     * you might want to prioritize look-up performance by using `std::map`, `std::unordered_map`
-     * or custom types with custom deserialization. To do this, use kw_arguments<Map>() or
-     * get_kw_arguments<Map>(map), then access the items from there.
+     * Small maps are searched by comparing key strings, without allocating memory. Maps with
+     * more than wamp_kw_lookup::INDEX_THRESHOLD entries get a hash index with the first look-up,
+     * which makes further look-ups O(1). A wamp_kw_key hashes its key once for all look-ups.
      *
      * Example:
      * `std::string id = event.kw_argument<std::string>("id");`
@@ -120,17 +146,18 @@ public:
     template <typename T>
     T kw_argument(const char* key) const;
 
+    template <typename T>
+    T kw_argument(const wamp_kw_key& key) const;
+
     /*!
      * The keyword argument published by the event with the given @p key, converted to type T,
      * or the given @p fallback if no such key was passed.
      *
-     * Overloads are provided for `std::string` and `char*` as @p key type.
+     * Overloads are provided for `std::string`, `char*` and autobahn::wamp_kw_key as @p key type.
      *
-     * This function uses key string comparisons to find the matching value, O(n) with n being
-     * the number of map elements. Memory allocation for keys is avoided though. For larger maps,
-     * you might want to prioritize look-up performance by using `std::map`, `std::unordered_map`
-     * or custom types with custom deserialization. To do this, use kw_arguments<Map>() or
-     * get_kw_arguments<Map>(map), then access the items from there.
+     * Small maps are searched by comparing key strings, without allocating memory. Maps with
+     * more than wamp_kw_lookup::INDEX_THRESHOLD entries get a hash index with the first look-up,
+     * which makes further look-ups O(1). A wamp_kw_key hashes its key once for all look-ups.
      *
      * Example:
      * `std::string id = event.kw_argument_or("id", std::string());`
@@ -143,6 +170,9 @@ public:
     template <typename T>
     T kw_argument_or(const char* key, const T& fallback) const;
 
+    template <typename T>
+    T kw_argument_or(const wamp_kw_key& key, const T& fallback) const;
+
     /*!
      * The keyword arguments published by the event, converted to a map type.
      *
@@ -168,15 +198,51 @@ public:
     template <typename Map>
     void get_kw_arguments(Map& kw_args) const;
 
+    /*!
+     * The encoded positional arguments published by the event, for passing them on with
+     * publish_raw(), call_raw() or result_raw() without decoding them.
+     *
+     * With lazy payloads (see wamp_session::set_lazy_payloads()) these are the
+     * bytes as received; otherwise the decoded arguments are encoded again with
+     * the first call. The span is empty if there are no arguments and valid as
+     * long as the event is.
+     */
+    wamp_msgpack_span raw_arguments() const;
+
+    /*!
+     * The encoded keyword arguments published by the event, see raw_arguments().
+     */
+    wamp_msgpack_span raw_kw_arguments() const;
+
     //
     // functions only called internally by wamp_session
 
     void set_arguments(const msgpack::object& arguments);
     void set_kw_arguments(const msgpack::object& kw_arguments);
+    void set_lazy_payload(const std::shared_ptr<wamp_lazy_payload>& payload);
+
+    /*!
+     * A copy of this event that keeps its payload alive. Shares the zone if this
+     * event owns one, otherwise deep-copies the payload into a new zone.
+     */
+    wamp_event owning_copy() const;
 
 private:
+    /// The arguments, decoded from the lazy payload if there is one.
+    const msgpack::object& arguments_object() const;
+    const msgpack::object& kw_arguments_object() const;
+
     msgpack::object m_arguments;
     msgpack::object m_kw_arguments;
+    wamp_kw_lookup m_kw_lookup;
+    wamp_raw_encoding m_raw_arguments;
+    wamp_raw_encoding m_raw_kw_arguments;
+
+    /// Zone holding the payload, shared by all copies of the event.
+    std::shared_ptr<msgpack::zone> m_zone;
+
+    /// The encoded payload of an event received in lazy mode.
+    std::shared_ptr<wamp_lazy_payload> m_lazy_payload;
 };
 
 } // namespace autobahn
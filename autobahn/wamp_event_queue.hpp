@@ -0,0 +1,85 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_EVENT_QUEUE_HPP
+#define AUTOBAHN_WAMP_EVENT_QUEUE_HPP
+
+#include "wamp_event.hpp"
+#include "wamp_event_handler.hpp"
+#include "wamp_subscribe_options.hpp"
+
+#include <atomic>
+#include <boost/asio.hpp>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+
+namespace autobahn {
+
+/*!
+ * A bounded serial queue that delivers the events of one subscription to its
+ * handler on an executor.
+ *
+ * At most one event of the queue is being handled at any time, so the handler
+ * sees events in the order they were received even when the executor is run by
+ * several threads.
+ */
+class wamp_event_queue : public std::enable_shared_from_this<wamp_event_queue>
+{
+public:
+    wamp_event_queue(const wamp_event_handler& handler, const wamp_subscribe_options& options);
+
+    /*!
+     * Queue an event for the handler, applying the overflow policy if the queue
+     * is full. The queued event keeps the payload alive until it was handled.
+     */
+    void push(const wamp_event& event);
+
+    /*!
+     * The number of events discarded because the queue was full.
+     */
+    uint64_t dropped() const;
+
+private:
+    /// Handle the event at the head of the queue, then reschedule if more are queued.
+    void drain();
+
+    wamp_event_handler m_handler;
+    std::shared_ptr<boost::asio::io_service> m_executor;
+    std::size_t m_max_queue_depth;
+    wamp_overflow_policy m_overflow_policy;
+
+    std::mutex m_mutex;
+    std::condition_variable m_not_full;
+
+    /// Events waiting for the handler.
+    std::deque<wamp_event> m_events;
+
+    /// Set while a drain() is posted to or running on the executor.
+    bool m_draining;
+
+    std::atomic<uint64_t> m_dropped;
+};
+
+} // namespace autobahn
+
+#include "wamp_event_queue.ipp"
+
+#endif // AUTOBAHN_WAMP_EVENT_QUEUE_HPP
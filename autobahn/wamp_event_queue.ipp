@@ -0,0 +1,102 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+
+namespace autobahn {
+
+inline wamp_event_queue::wamp_event_queue(
+        const wamp_event_handler& handler, const wamp_subscribe_options& options)
+    : m_handler(handler)
+    , m_executor(options.executor())
+    , m_max_queue_depth(std::max<std::size_t>(1, options.max_queue_depth()))
+    , m_overflow_policy(options.overflow_policy())
+    , m_mutex()
+    , m_not_full()
+    , m_events()
+    , m_draining(false)
+    , m_dropped(ATOMIC_VAR_INIT(0))
+{
+}
+
+inline void wamp_event_queue::push(const wamp_event& event)
+{
+    // Events from the session share their zone, so this only copies the payload
+    // of events that were constructed without one.
+    wamp_event owned_event = event.owning_copy();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_events.size() >= m_max_queue_depth) {
+        switch (m_overflow_policy) {
+            case wamp_overflow_policy::drop_newest:
+                ++m_dropped;
+                return;
+            case wamp_overflow_policy::drop_oldest:
+                m_events.pop_front();
+                ++m_dropped;
+                break;
+            case wamp_overflow_policy::block:
+                m_not_full.wait(lock, [this]() { return m_events.size() < m_max_queue_depth; });
+                break;
+        }
+    }
+
+    m_events.push_back(std::move(owned_event));
+
+    if (!m_draining) {
+        m_draining = true;
+        auto self = shared_from_this();
+        m_executor->post([self]() { self->drain(); });
+    }
+}
+
+inline uint64_t wamp_event_queue::dropped() const
+{
+    return m_dropped;
+}
+
+inline void wamp_event_queue::drain()
+{
+    wamp_event event;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        event = std::move(m_events.front());
+        m_events.pop_front();
+    }
+    m_not_full.notify_one();
+
+    try {
+        m_handler(event);
+    } catch (...) {
+        // Same as for inline handlers: a throwing handler must not take down
+        // the delivery of later events.
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_events.empty()) {
+        m_draining = false;
+    } else {
+        // One event per task keeps queues of different subscriptions that share
+        // an executor from starving each other.
+        auto self = shared_from_this();
+        m_executor->post([self]() { self->drain(); });
+    }
+}
+
+} // namespace autobahn
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_FRAMES_HPP
+#define AUTOBAHN_WAMP_FRAMES_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <msgpack.hpp>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * WAMP messages serialized back-to-back with their rawsocket length prefixes,
+ * ready to be written to the transport at once.
+ *
+ * Each message carries a fixed-width request ID placeholder, so that request
+ * IDs can be assigned right before the messages are sent.
+ */
+class wamp_frames
+{
+public:
+    wamp_frames();
+    wamp_frames(wamp_frames&&) = default;
+    wamp_frames& operator=(wamp_frames&&) = default;
+
+    // The serialized messages are patched when sent, so frames are never shared.
+    wamp_frames(const wamp_frames&) = delete;
+    wamp_frames& operator=(const wamp_frames&) = delete;
+
+    /// The buffer messages are packed into.
+    msgpack::sbuffer& buffer();
+
+    /// The serialized messages, including their length prefixes.
+    const std::shared_ptr<msgpack::sbuffer>& frames() const;
+
+    /// The number of messages.
+    std::size_t size() const;
+
+    bool empty() const;
+
+    /// Start a message; its length prefix is filled in by end_frame().
+    void begin_frame();
+
+    /// Pack the request ID placeholder of the current message.
+    void pack_request_id(msgpack::packer<msgpack::sbuffer>& packer);
+
+    void end_frame();
+
+    /// Write consecutive request IDs, starting at @p first_request_id, into the messages.
+    void set_request_ids(uint64_t first_request_id);
+
+private:
+    std::shared_ptr<msgpack::sbuffer> m_frames;
+
+    /// Offset of the message started last.
+    std::size_t m_frame_offset;
+
+    /// Offsets of the request ID placeholders, one per message.
+    std::vector<std::size_t> m_request_id_offsets;
+};
+
+} // namespace autobahn
+
+#include "wamp_frames.ipp"
+
+#endif // AUTOBAHN_WAMP_FRAMES_HPP
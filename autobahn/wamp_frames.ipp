@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_frames::wamp_frames()
+    : m_frames(std::make_shared<msgpack::sbuffer>())
+    , m_frame_offset(0)
+    , m_request_id_offsets()
+{
+}
+
+inline msgpack::sbuffer& wamp_frames::buffer()
+{
+    return *m_frames;
+}
+
+inline const std::shared_ptr<msgpack::sbuffer>& wamp_frames::frames() const
+{
+    return m_frames;
+}
+
+inline std::size_t wamp_frames::size() const
+{
+    return m_request_id_offsets.size();
+}
+
+inline bool wamp_frames::empty() const
+{
+    return m_request_id_offsets.empty();
+}
+
+inline void wamp_frames::begin_frame()
+{
+    m_frame_offset = m_frames->size();
+    const char length_prefix[4] = { 0, 0, 0, 0 };
+    m_frames->write(length_prefix, sizeof(length_prefix));
+}
+
+inline void wamp_frames::pack_request_id(msgpack::packer<msgpack::sbuffer>& packer)
+{
+    // Skip the type byte of the fixed-width uint64 to get to its payload.
+    m_request_id_offsets.push_back(m_frames->size() + 1);
+    packer.pack_fix_uint64(0);
+}
+
+inline void wamp_frames::end_frame()
+{
+    std::size_t length = m_frames->size() - m_frame_offset - 4;
+    char* length_prefix = m_frames->data() + m_frame_offset;
+
+    length_prefix[0] = static_cast<char>(length >> 24);
+    length_prefix[1] = static_cast<char>(length >> 16);
+    length_prefix[2] = static_cast<char>(length >> 8);
+    length_prefix[3] = static_cast<char>(length);
+}
+
+inline void wamp_frames::set_request_ids(uint64_t first_request_id)
+{
+    char* data = m_frames->data();
+    uint64_t request_id = first_request_id;
+
+    for (std::size_t offset : m_request_id_offsets) {
+        // Big endian payload of the msgpack uint64 written by pack_fix_uint64.
+        for (int byte = 7; byte >= 0; --byte) {
+            data[offset + byte] = static_cast<char>(request_id >> (8 * (7 - byte)));
+        }
+        ++request_id;
+    }
+}
+
+} // namespace autobahn
@@ -20,7 +20,17 @@
 #define AUTOBAHN_WAMP_INVOCATION_HPP
 
 #include "wamp_arguments.hpp"
+#include "wamp_kw_index.hpp"
+#include "wamp_lazy_payload.hpp"
+#include "wamp_raw_payload.hpp"
 
+// http://stackoverflow.com/questions/22597948/using-boostfuture-with-then-continuations/
+#define BOOST_THREAD_PROVIDES_FUTURE
+#define BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+#define BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+#include <boost/thread/future.hpp>
+
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <memory>
@@ -43,12 +53,11 @@ public:
     /*!
      * The detail passed by the router with the given @p key, converted to type T.
      *
-     * Overloads are provided for `std::string` and `char*` as @p key type.
+     * Overloads are provided for `std::string`, `char*` and autobahn::wamp_kw_key as @p key type.
      *
-     * This function uses key string comparisons to find the matching value, O(n) with n being
-     * the number of map elements. Memory allocation for keys is avoided though. For larger maps,
-     * you might want to prioritize look-up performance by using `std::map`, `std::unordered_map`
-     * or custom types with custom deserialization. To do this, use details<Map>(), then access the items from there.
+     * Small maps are searched by comparing key strings, without allocating memory. Maps with
+     * more than wamp_kw_lookup::INDEX_THRESHOLD entries get a hash index with the first look-up,
+     * which makes further look-ups O(1). A wamp_kw_key hashes its key once for all look-ups.
      *
      * Example:
      * `std::string invoked_procedure = invocation->detail<std::string>("procedure");`
@@ -60,6 +69,9 @@ public:
     template <typename T>
     T detail(const char *key) const;
 
+    template <typename T>
+    T detail(const wamp_kw_key& key) const;
+
     /*!
      * The details passed to the invocation from the router, converted to a map type.
      *
@@ -71,6 +83,27 @@ public:
     template<typename Map>
     Map details() const;
 
+    /*!
+     * Whether the caller set a timeout for the call, which the router passes on
+     * in the "timeout" detail (in milliseconds).
+     */
+    bool has_deadline() const;
+
+    /*!
+     * The time left until the caller's timeout passes, counted from when the
+     * invocation was received and rounded down to milliseconds. Zero once the
+     * timeout has passed, and std::chrono::milliseconds::max() if the call has no
+     * timeout.
+     *
+     * Procedures doing lengthy work can use this to give up early. Invocations
+     * that expire while waiting in the queue of a registration with an executor
+     * (see wamp_invocation_options) are answered with an error without running.
+     */
+    std::chrono::milliseconds remaining_time() const;
+
+    /// Whether the caller's timeout has passed.
+    bool expired() const;
+
     /*!
      * The number of positional arguments passed to the invocation.
      */
@@ -140,13 +173,11 @@ public:
     /*!
      * The keyword argument passed to the invocation with the given @p key, converted to type T.
      *
-     * Overloads are provided for `std::string` and `char*` as @p key type.
+     * Overloads are provided for `std::string`, `char*` and autobahn::wamp_kw_key as @p key type.
      *
-     * This function uses key string comparisons to find the matching value, O(n) with n being
-     * the number of map elements. Memory allocation for keys is avoided though. For larger maps,
-     * you might want to prioritize look-up performance by using `std::map`, `std::unordered_map`
-     * or custom types with custom deserialization. To do this, use kw_arguments<Map>() or
-     * get_kw_arguments<Map>(map), then access the items from there.
+     * Small maps are searched by comparing key strings, without allocating memory. Maps with
+     * more than wamp_kw_lookup::INDEX_THRESHOLD entries get a hash index with the first look-up,
+     * which makes further look-ups O(1). A wamp_kw_key hashes its key once for all look-ups.
      *
      * Example:
      * `std::string id = invocation->kw_argument<std::string>("id");`
@@ -160,17 +191,18 @@ public:
     template <typename T>
     T kw_argument(const char* key) const;
 
+    template <typename T>
+    T kw_argument(const wamp_kw_key& key) const;
+
     /*!
      * The keyword argument passed to the invocation with the given @p key, converted to type T,
      * or the given @p fallback if no such key was passed.
      *
-     * Overloads are provided for `std::string` and `char*` as @p key type.
+     * Overloads are provided for `std::string`, `char*` and autobahn::wamp_kw_key as @p key type.
      *
-     * This function uses key string comparisons to find the matching value, O(n) with n being
-     * the number of map elements. Memory allocation for keys is avoided though. For larger maps,
-     * you might want to prioritize look-up performance by using `std::map`, `std::unordered_map`
-     * or custom types with custom deserialization. To do this, use kw_arguments<Map>() or
-     * get_kw_arguments<Map>(map), then access the items from there.
+     * Small maps are searched by comparing key strings, without allocating memory. Maps with
+     * more than wamp_kw_lookup::INDEX_THRESHOLD entries get a hash index with the first look-up,
+     * which makes further look-ups O(1). A wamp_kw_key hashes its key once for all look-ups.
      *
      * Example:
      * `std::string id = invocation->kw_argument_or("id", std::string());`
@@ -183,6 +215,9 @@ public:
     template <typename T>
     T kw_argument_or(const char* key, const T& fallback) const;
 
+    template <typename T>
+    T kw_argument_or(const wamp_kw_key& key, const T& fallback) const;
+
     /*!
      * The keyword arguments passed to the invocation, converted to a map type.
      *
@@ -208,6 +243,22 @@ public:
     template <typename Map>
     void get_kw_arguments(Map& kw_args) const;
 
+    /*!
+     * The encoded positional arguments of the invocation, for passing them on with
+     * publish_raw(), call_raw() or result_raw() without decoding them.
+     *
+     * With lazy payloads (see wamp_session::set_lazy_payloads()) these are the
+     * bytes as received; otherwise the decoded arguments are encoded again with
+     * the first call. The span is empty if there are no arguments and valid as
+     * long as the invocation is.
+     */
+    wamp_msgpack_span raw_arguments() const;
+
+    /*!
+     * The encoded keyword arguments of the invocation, see raw_arguments().
+     */
+    wamp_msgpack_span raw_kw_arguments() const;
+
     /*!
      * Reply to the invocation with an empty result.
      */
@@ -225,6 +276,49 @@ public:
     template <typename List, typename Map>
     void result(const List& arguments, const Map& kw_arguments);
 
+    /*!
+     * Reply to the invocation with already encoded positional and keyword
+     * arguments, which are checked to hold one complete element each and copied
+     * into the message as they are. An empty span leaves out the respective
+     * arguments.
+     *
+     * Example:
+     * `invocation->result_raw(result.raw_arguments(), result.raw_kw_arguments());`
+     *
+     * @throw std::invalid_argument if @p arguments is not exactly one complete
+     *        msgpack array or @p kw_arguments is not exactly one complete msgpack map
+     */
+    void result_raw(const wamp_msgpack_span& arguments,
+            const wamp_msgpack_span& kw_arguments = wamp_msgpack_span());
+
+    /*!
+     * Whether the caller asked for progressive results, which makes progress()
+     * available for this invocation.
+     */
+    bool receive_progress() const;
+
+    /*!
+     * Send a progressive result with positional arguments. Any number of them
+     * may precede the final result() or error().
+     *
+     * The returned future resolves once the chunk was written to the transport.
+     * A procedure producing a large result on an executor can wait for it
+     * before producing the next chunk, so that no more than one chunk at a time
+     * is held in memory.
+     *
+     * @throw std::runtime_error if the caller did not ask for progressive results
+     */
+    template <typename List>
+    boost::future<void> progress(const List& arguments);
+
+    /*!
+     * Send a progressive result with positional and keyword arguments.
+     *
+     * @throw std::runtime_error if the caller did not ask for progressive results
+     */
+    template <typename List, typename Map>
+    boost::future<void> progress(const List& arguments, const Map& kw_arguments);
+
     /*!
      * Reply to the invocation with an error and no further details.
      */
@@ -249,22 +343,46 @@ public:
 
     using send_result_fn = std::function<void(const std::shared_ptr<msgpack::sbuffer>&)>;
     void set_send_result_fn(send_result_fn&&);
+    /// Keep @p resource alive until the invocation has been answered or destroyed.
+    void hold_until_answered(const std::shared_ptr<void>& resource);
+    using send_progress_fn = std::function<boost::future<void>(const std::shared_ptr<msgpack::sbuffer>&)>;
+    void set_send_progress_fn(send_progress_fn&&);
     void set_request_id(std::uint64_t);
     void set_details(const msgpack::object& details);
-    void set_zone(msgpack::zone&&);
+    void set_zone(const std::shared_ptr<msgpack::zone>& zone);
     void set_arguments(const msgpack::object& arguments);
     void set_kw_arguments(const msgpack::object& kw_arguments);
+    void set_lazy_payload(const std::shared_ptr<wamp_lazy_payload>& payload);
     bool sendable() const;
 
 private:
     void throw_if_not_sendable();
+    void throw_if_not_progressive();
+
+    /// The arguments, decoded from the lazy payload if there is one.
+    const msgpack::object& arguments_object() const;
+    const msgpack::object& kw_arguments_object() const;
 
 private:
-    msgpack::zone m_zone;
+    std::shared_ptr<msgpack::zone> m_zone;
     msgpack::object m_details;
+    wamp_kw_lookup m_details_lookup;
+
+    /// When the caller's timeout passes, if m_has_deadline.
+    std::chrono::steady_clock::time_point m_deadline;
+    bool m_has_deadline;
+
     msgpack::object m_arguments;
     msgpack::object m_kw_arguments;
+    wamp_kw_lookup m_kw_lookup;
+    wamp_raw_encoding m_raw_arguments;
+    wamp_raw_encoding m_raw_kw_arguments;
+
+    /// The encoded payload of an invocation received in lazy mode.
+    std::shared_ptr<wamp_lazy_payload> m_lazy_payload;
+
     send_result_fn m_send_result_fn;
+    send_progress_fn m_send_progress_fn;
     std::uint64_t m_request_id;
 };
 
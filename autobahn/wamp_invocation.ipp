@@ -16,8 +16,10 @@
 //
 ///////////////////////////////////////////////////////////////////////////////
 
+#include "wamp_message.hpp"
 #include "wamp_message_type.hpp"
 
+#include <algorithm>
 #include <boost/lexical_cast.hpp>
 #include <stdexcept>
 #include <tuple>
@@ -27,9 +29,17 @@ namespace autobahn {
 inline wamp_invocation_impl::wamp_invocation_impl()
     : m_zone()
     , m_details(EMPTY_DETAILS)
+    , m_details_lookup()
+    , m_deadline()
+    , m_has_deadline(false)
     , m_arguments(EMPTY_ARGUMENTS)
     , m_kw_arguments(EMPTY_KW_ARGUMENTS)
+    , m_kw_lookup()
+    , m_raw_arguments()
+    , m_raw_kw_arguments()
+    , m_lazy_payload()
     , m_send_result_fn()
+    , m_send_progress_fn()
     , m_request_id(0)
 {
 }
@@ -37,36 +47,31 @@ inline wamp_invocation_impl::wamp_invocation_impl()
 template <typename T>
 T wamp_invocation_impl::details(const std::string& key) const
 {
-    if (m_details.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
+    const msgpack::object* value = m_details_lookup.find(m_details, key.data(), key.size());
+    if (!value) {
+        throw std::out_of_range(key + " detail doesn't exist");
     }
-    for (std::size_t i = 0; i < m_details.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_details.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key.size() == kv.key.via.str.size
-            && key.compare(0, key.size(), kv.key.via.str.ptr, kv.key.via.str.size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    throw std::out_of_range(key + " detail doesn't exist");
+    return value->as<T>();
 }
 
 template <typename T>
 T wamp_invocation_impl::detail(const char *key) const
 {
-    if (m_details.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
+    const msgpack::object* value = m_details_lookup.find(m_details, key, strlen(key));
+    if (!value) {
+        throw std::out_of_range(std::string(key) + " detail doesn't exist");
     }
-    std::size_t key_size = strlen(key);
-    for (std::size_t i = 0; i < m_details.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_details.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key_size == kv.key.via.str.size
-            && memcmp(key, kv.key.via.str.ptr, key_size) == 0)
-        {
-            return kv.val.as<T>();
-        }
+    return value->as<T>();
+}
+
+template <typename T>
+T wamp_invocation_impl::detail(const wamp_kw_key& key) const
+{
+    const msgpack::object* value = m_details_lookup.find(m_details, key);
+    if (!value) {
+        throw std::out_of_range(std::string(key.data(), key.size()) + " detail doesn't exist");
     }
-    throw std::out_of_range(std::string(key) + " detail doesn't exist");
+    return value->as<T>();
 }
 
 template<typename Map>
@@ -75,19 +80,51 @@ Map wamp_invocation_impl::details() const
     return m_details.as<Map>();
 }
 
+inline bool wamp_invocation_impl::has_deadline() const
+{
+    return m_has_deadline;
+}
+
+inline std::chrono::milliseconds wamp_invocation_impl::remaining_time() const
+{
+    if (!m_has_deadline) {
+        return std::chrono::milliseconds::max();
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (now >= m_deadline) {
+        return std::chrono::milliseconds(0);
+    }
+    return std::chrono::duration_cast<std::chrono::milliseconds>(m_deadline - now);
+}
+
+inline bool wamp_invocation_impl::expired() const
+{
+    return m_has_deadline && std::chrono::steady_clock::now() >= m_deadline;
+}
+
 inline std::size_t wamp_invocation_impl::number_of_arguments() const
 {
+    if (m_lazy_payload) {
+        return m_lazy_payload->number_of_arguments();
+    }
     return m_arguments.type == msgpack::type::ARRAY ? m_arguments.via.array.size : 0;
 }
 
 inline std::size_t wamp_invocation_impl::number_of_kw_arguments() const
 {
+    if (m_lazy_payload) {
+        return m_lazy_payload->number_of_kw_arguments();
+    }
     return m_kw_arguments.type == msgpack::type::MAP ? m_kw_arguments.via.map.size : 0;
 }
 
 template <typename T>
 inline T wamp_invocation_impl::argument(std::size_t index) const
 {
+    if (m_lazy_payload) {
+        return m_lazy_payload->argument(index).as<T>();
+    }
     if (m_arguments.type != msgpack::type::ARRAY || m_arguments.via.array.size <= index) {
         throw std::out_of_range("no argument at index " + boost::lexical_cast<std::string>(index));
     }
@@ -97,102 +134,76 @@ inline T wamp_invocation_impl::argument(std::size_t index) const
 template <typename List>
 inline List wamp_invocation_impl::arguments() const
 {
-    return m_arguments.as<List>();
+    return arguments_object().as<List>();
 }
 
 template <typename List>
 inline void wamp_invocation_impl::get_arguments(List& args) const
 {
-    m_arguments.convert(args);
+    arguments_object().convert(args);
 }
 
 template <typename... T>
 inline void wamp_invocation_impl::get_each_argument(T&... args) const
 {
     auto args_tuple = std::make_tuple(std::ref(args)...);
-    m_arguments.convert(args_tuple);
+    arguments_object().convert(args_tuple);
 }
 
 template <typename T>
 inline T wamp_invocation_impl::kw_argument(const std::string& key) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key.size() == kv.key.via.str.size
-                && key.compare(0, key.size(), kv.key.via.str.ptr, kv.key.via.str.size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    throw std::out_of_range(key + " keyword argument doesn't exist");
+    return detail::require_kw_argument(
+            m_lazy_payload, m_kw_lookup, m_kw_arguments, key.data(), key.size()).as<T>();
 }
 
 template <typename T>
 inline T wamp_invocation_impl::kw_argument(const char* key) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    std::size_t key_size = strlen(key);
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key_size == kv.key.via.str.size
-                && memcmp(key, kv.key.via.str.ptr, key_size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    throw std::out_of_range(std::string(key) + " keyword argument doesn't exist");
+    return detail::require_kw_argument(
+            m_lazy_payload, m_kw_lookup, m_kw_arguments, key, strlen(key)).as<T>();
 }
 
 template <typename T>
 inline T wamp_invocation_impl::kw_argument_or(const std::string& key, const T& fallback) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key.size() == kv.key.via.str.size
-                && key.compare(0, key.size(), kv.key.via.str.ptr, kv.key.via.str.size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    return fallback;
+    const msgpack::object* value = detail::find_kw_argument(
+            m_lazy_payload, m_kw_lookup, m_kw_arguments, key.data(), key.size());
+    return value ? value->as<T>() : fallback;
 }
 
 template <typename T>
 inline T wamp_invocation_impl::kw_argument_or(const char* key, const T& fallback) const
 {
-    if (m_kw_arguments.type != msgpack::type::MAP) {
-        throw msgpack::type_error();
-    }
-    std::size_t key_size = strlen(key);
-    for (std::size_t i = 0; i < m_kw_arguments.via.map.size; ++i) {
-        const msgpack::object_kv& kv = m_kw_arguments.via.map.ptr[i];
-        if (kv.key.type == msgpack::type::STR && key_size == kv.key.via.str.size
-                && memcmp(key, kv.key.via.str.ptr, key_size) == 0)
-        {
-            return kv.val.as<T>();
-        }
-    }
-    throw fallback;
+    const msgpack::object* value = detail::find_kw_argument(
+            m_lazy_payload, m_kw_lookup, m_kw_arguments, key, strlen(key));
+    return value ? value->as<T>() : fallback;
+}
+
+template <typename T>
+inline T wamp_invocation_impl::kw_argument(const wamp_kw_key& key) const
+{
+    return detail::require_kw_argument(m_lazy_payload, m_kw_lookup, m_kw_arguments, key).as<T>();
+}
+
+template <typename T>
+inline T wamp_invocation_impl::kw_argument_or(const wamp_kw_key& key, const T& fallback) const
+{
+    const msgpack::object* value = detail::find_kw_argument(
+            m_lazy_payload, m_kw_lookup, m_kw_arguments, key);
+    return value ? value->as<T>() : fallback;
 }
 
 template <typename Map>
 inline Map wamp_invocation_impl::kw_arguments() const
 {
-    return m_kw_arguments.as<Map>();
+    return kw_arguments_object().as<Map>();
 }
 
 template <typename Map>
 inline void wamp_invocation_impl::get_kw_arguments(Map& kw_args) const
 {
-    m_kw_arguments.convert(kw_args);
+    kw_arguments_object().convert(kw_args);
 }
 
 inline void wamp_invocation_impl::empty_result()
@@ -252,6 +263,75 @@ inline void wamp_invocation_impl::result(
     m_send_result_fn = send_result_fn();
 }
 
+inline void wamp_invocation_impl::result_raw(
+        const wamp_msgpack_span& arguments, const wamp_msgpack_span& kw_arguments)
+{
+    std::size_t payload_elements = detail::raw_payload_elements(arguments, kw_arguments);
+    throw_if_not_sendable();
+
+    auto buffer = std::make_shared<msgpack::sbuffer>(32 + arguments.size() + kw_arguments.size());
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+
+    // [YIELD, INVOCATION.Request|id, Options|dict, Arguments|list, ArgumentsKw|dict]
+    packer.pack_array(3 + payload_elements);
+    packer.pack(static_cast<int>(message_type::YIELD));
+    packer.pack(m_request_id);
+    packer.pack_map(0);
+    detail::write_raw_payload(*buffer, arguments, kw_arguments);
+
+    m_send_result_fn(buffer);
+    m_send_result_fn = send_result_fn();
+}
+
+inline bool wamp_invocation_impl::receive_progress() const
+{
+    const msgpack::object* receive_progress = find_detail(m_details, "receive_progress");
+    return receive_progress && receive_progress->type == msgpack::type::BOOLEAN &&
+            receive_progress->via.boolean;
+}
+
+template<typename List>
+inline boost::future<void> wamp_invocation_impl::progress(const List& arguments)
+{
+    throw_if_not_progressive();
+
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+
+    // [YIELD, INVOCATION.Request|id, Options|dict, Arguments|list]
+    packer.pack_array(4);
+    packer.pack(static_cast<int>(message_type::YIELD));
+    packer.pack(m_request_id);
+    packer.pack_map(1);
+    packer.pack(std::string("progress"));
+    packer.pack(true);
+    packer.pack(arguments);
+
+    return m_send_progress_fn(buffer);
+}
+
+template<typename List, typename Map>
+inline boost::future<void> wamp_invocation_impl::progress(
+        const List& arguments, const Map& kw_arguments)
+{
+    throw_if_not_progressive();
+
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+
+    // [YIELD, INVOCATION.Request|id, Options|dict, Arguments|list, ArgumentsKw|dict]
+    packer.pack_array(5);
+    packer.pack(static_cast<int>(message_type::YIELD));
+    packer.pack(m_request_id);
+    packer.pack_map(1);
+    packer.pack(std::string("progress"));
+    packer.pack(true);
+    packer.pack(arguments);
+    packer.pack(kw_arguments);
+
+    return m_send_progress_fn(buffer);
+}
+
 inline void wamp_invocation_impl::error(const std::string& error_uri)
 {
     throw_if_not_sendable();
@@ -321,6 +401,24 @@ inline void wamp_invocation_impl::set_send_result_fn(send_result_fn&& send_resul
     m_send_result_fn = std::move(send_result);
 }
 
+inline void wamp_invocation_impl::hold_until_answered(const std::shared_ptr<void>& resource)
+{
+    if (!sendable()) {
+        return;
+    }
+
+    // The send function is dropped once the answer is sent, and with it the resource.
+    send_result_fn send_result = std::move(m_send_result_fn);
+    m_send_result_fn = [send_result, resource](const std::shared_ptr<msgpack::sbuffer>& buffer) {
+        send_result(buffer);
+    };
+}
+
+inline void wamp_invocation_impl::set_send_progress_fn(send_progress_fn&& send_progress)
+{
+    m_send_progress_fn = std::move(send_progress);
+}
+
 inline void wamp_invocation_impl::set_request_id(std::uint64_t request_id)
 {
     m_request_id = request_id;
@@ -329,21 +427,66 @@ inline void wamp_invocation_impl::set_request_id(std::uint64_t request_id)
 inline void wamp_invocation_impl::set_details(const msgpack::object& details)
 {
     m_details = details;
+    m_details_lookup.reset();
+
+    // The session sets the details as it receives the invocation, which is where
+    // the caller's timeout starts counting on this side.
+    const msgpack::object* timeout = m_details_lookup.find(m_details, "timeout", 7);
+    m_has_deadline = timeout && timeout->type == msgpack::type::POSITIVE_INTEGER && timeout->via.u64 > 0;
+    if (m_has_deadline) {
+        // Clamped to a year, which keeps the deadline from overflowing.
+        const uint64_t milliseconds = std::min<uint64_t>(timeout->via.u64, 365ULL * 24 * 60 * 60 * 1000);
+        m_deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(milliseconds);
+    }
 }
 
-inline void wamp_invocation_impl::set_zone(msgpack::zone&& zone)
+inline void wamp_invocation_impl::set_zone(const std::shared_ptr<msgpack::zone>& zone)
 {
-    m_zone = std::move(zone);
+    m_zone = zone;
+}
+
+inline wamp_msgpack_span wamp_invocation_impl::raw_arguments() const
+{
+    if (m_lazy_payload) {
+        return m_lazy_payload->raw_arguments();
+    }
+    return m_raw_arguments.span(m_arguments);
+}
+
+inline wamp_msgpack_span wamp_invocation_impl::raw_kw_arguments() const
+{
+    if (m_lazy_payload) {
+        return m_lazy_payload->raw_kw_arguments();
+    }
+    return m_raw_kw_arguments.span(m_kw_arguments);
 }
 
 inline void wamp_invocation_impl::set_arguments(const msgpack::object& arguments)
 {
     m_arguments = arguments;
+    m_raw_arguments.reset();
 }
 
 inline void wamp_invocation_impl::set_kw_arguments(const msgpack::object& kw_arguments)
 {
     m_kw_arguments = kw_arguments;
+    m_kw_lookup.reset();
+    m_raw_kw_arguments.reset();
+}
+
+inline void wamp_invocation_impl::set_lazy_payload(const std::shared_ptr<wamp_lazy_payload>& payload)
+{
+    m_lazy_payload = payload;
+}
+
+inline const msgpack::object& wamp_invocation_impl::arguments_object() const
+{
+    return m_lazy_payload ? m_lazy_payload->arguments() : m_arguments;
+}
+
+inline const msgpack::object& wamp_invocation_impl::kw_arguments_object() const
+{
+    return m_lazy_payload ? m_lazy_payload->kw_arguments() : m_kw_arguments;
 }
 
 inline bool wamp_invocation_impl::sendable() const
@@ -359,4 +502,14 @@ inline void wamp_invocation_impl::throw_if_not_sendable()
     }
 }
 
+inline void wamp_invocation_impl::throw_if_not_progressive()
+{
+    throw_if_not_sendable();
+
+    if (!m_send_progress_fn || !receive_progress()) {
+        throw std::runtime_error("tried to call progress() but the caller did not "
+                "ask for progressive results");
+    }
+}
+
 } // namespace autobahn
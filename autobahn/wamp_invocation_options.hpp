@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_INVOCATION_OPTIONS_HPP
+#define AUTOBAHN_WAMP_INVOCATION_OPTIONS_HPP
+
+#include <boost/asio.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+namespace autobahn {
+
+/*!
+ * Local options for how the invocations of a provided procedure are executed.
+ *
+ * These never reach the router; options for the REGISTER message itself are
+ * passed as provide_options.
+ */
+class wamp_invocation_options
+{
+public:
+    wamp_invocation_options();
+
+    /*!
+     * The executor that runs the procedure, or null to run it inline on the
+     * session's io thread (the default).
+     */
+    const std::shared_ptr<boost::asio::io_service>& executor() const;
+
+    /*!
+     * The maximum number of invocations of the registration executing at the
+     * same time, zero for no limit. An invocation counts until it has been
+     * answered or destroyed, not just while the procedure runs.
+     */
+    std::size_t max_concurrency() const;
+
+    /*!
+     * The maximum number of invocations waiting for an execution slot. Further
+     * invocations are rejected right away.
+     */
+    std::size_t max_queued() const;
+
+    /*!
+     * The error URI invocations are rejected with when the queue is full.
+     */
+    const std::string& overload_error() const;
+
+    /*!
+     * The error URI queued invocations are answered with, instead of running,
+     * when the caller's timeout passes before an execution slot frees up.
+     *
+     * \see wamp_invocation_impl::remaining_time
+     */
+    const std::string& timeout_error() const;
+
+    /*!
+     * Run the procedure on @p executor, which may be run by any number of threads.
+     */
+    void set_executor(const std::shared_ptr<boost::asio::io_service>& executor);
+
+    void set_max_concurrency(std::size_t max_concurrency);
+
+    void set_max_queued(std::size_t max_queued);
+
+    void set_overload_error(const std::string& error_uri);
+
+    void set_timeout_error(const std::string& error_uri);
+
+private:
+    std::shared_ptr<boost::asio::io_service> m_executor;
+    std::size_t m_max_concurrency;
+    std::size_t m_max_queued;
+    std::string m_overload_error;
+    std::string m_timeout_error;
+};
+
+} // namespace autobahn
+
+#include "wamp_invocation_options.ipp"
+
+#endif // AUTOBAHN_WAMP_INVOCATION_OPTIONS_HPP
@@ -0,0 +1,80 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_invocation_options::wamp_invocation_options()
+    : m_executor()
+    , m_max_concurrency(0)
+    , m_max_queued(1024)
+    , m_overload_error("wamp.error.unavailable")
+    , m_timeout_error("wamp.error.timeout")
+{
+}
+
+inline const std::shared_ptr<boost::asio::io_service>& wamp_invocation_options::executor() const
+{
+    return m_executor;
+}
+
+inline std::size_t wamp_invocation_options::max_concurrency() const
+{
+    return m_max_concurrency;
+}
+
+inline std::size_t wamp_invocation_options::max_queued() const
+{
+    return m_max_queued;
+}
+
+inline const std::string& wamp_invocation_options::overload_error() const
+{
+    return m_overload_error;
+}
+
+inline const std::string& wamp_invocation_options::timeout_error() const
+{
+    return m_timeout_error;
+}
+
+inline void wamp_invocation_options::set_executor(const std::shared_ptr<boost::asio::io_service>& executor)
+{
+    m_executor = executor;
+}
+
+inline void wamp_invocation_options::set_max_concurrency(std::size_t max_concurrency)
+{
+    m_max_concurrency = max_concurrency;
+}
+
+inline void wamp_invocation_options::set_max_queued(std::size_t max_queued)
+{
+    m_max_queued = max_queued;
+}
+
+inline void wamp_invocation_options::set_overload_error(const std::string& error_uri)
+{
+    m_overload_error = error_uri;
+}
+
+inline void wamp_invocation_options::set_timeout_error(const std::string& error_uri)
+{
+    m_timeout_error = error_uri;
+}
+
+} // namespace autobahn
@@ -0,0 +1,97 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_INVOCATION_QUEUE_HPP
+#define AUTOBAHN_WAMP_INVOCATION_QUEUE_HPP
+
+#include "wamp_invocation.hpp"
+#include "wamp_invocation_options.hpp"
+#include "wamp_procedure.hpp"
+
+#include <boost/asio.hpp>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * Runs the invocations of one registration on an executor, with a cap on how
+ * many execute at the same time.
+ *
+ * An invocation counts against the cap until it has been answered or destroyed,
+ * so a procedure that answers later, from another thread, keeps its slot until
+ * it does.
+ *
+ * Invocations beyond the cap wait in a bounded queue; once that is full they are
+ * answered with an error immediately instead of waiting behind the backlog.
+ * Invocations whose caller's timeout passes while they wait are answered with
+ * an error instead of running, and make room in a full queue.
+ */
+class wamp_invocation_queue : public std::enable_shared_from_this<wamp_invocation_queue>
+{
+public:
+    wamp_invocation_queue(const wamp_procedure& procedure, const wamp_invocation_options& options);
+
+    /*!
+     * Execute @p invocation as soon as there is a free execution slot, or reject it
+     * if too many invocations are already waiting.
+     */
+    void push(const wamp_invocation& invocation);
+
+private:
+    /// Held by an executing invocation until it has been answered or destroyed.
+    class execution_slot
+    {
+    public:
+        explicit execution_slot(const std::shared_ptr<wamp_invocation_queue>& queue);
+        ~execution_slot();
+
+    private:
+        std::shared_ptr<wamp_invocation_queue> m_queue;
+    };
+
+    /// Execute one invocation, holding its execution slot until it is answered.
+    void execute(wamp_invocation invocation);
+
+    /// Hand a freed execution slot to the next waiting invocation, if any.
+    void release_slot();
+
+    wamp_procedure m_procedure;
+    std::shared_ptr<boost::asio::io_service> m_executor;
+    std::size_t m_max_concurrency;
+    std::size_t m_max_queued;
+    std::string m_overload_error;
+    std::string m_timeout_error;
+
+    std::mutex m_mutex;
+
+    /// Invocations waiting for an execution slot.
+    std::deque<wamp_invocation> m_waiting;
+
+    /// Invocations posted to or executing on the executor.
+    std::size_t m_executing;
+};
+
+} // namespace autobahn
+
+#include "wamp_invocation_queue.ipp"
+
+#endif // AUTOBAHN_WAMP_INVOCATION_QUEUE_HPP
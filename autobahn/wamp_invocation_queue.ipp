@@ -0,0 +1,147 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <exception>
+#include <map>
+#include <string>
+
+namespace autobahn {
+
+inline wamp_invocation_queue::wamp_invocation_queue(
+        const wamp_procedure& procedure, const wamp_invocation_options& options)
+    : m_procedure(procedure)
+    , m_executor(options.executor())
+    , m_max_concurrency(options.max_concurrency())
+    , m_max_queued(options.max_queued())
+    , m_overload_error(options.overload_error())
+    , m_timeout_error(options.timeout_error())
+    , m_mutex()
+    , m_waiting()
+    , m_executing(0)
+{
+}
+
+inline void wamp_invocation_queue::push(const wamp_invocation& invocation)
+{
+    bool queued = false;
+    bool rejected = false;
+    std::vector<wamp_invocation> expired;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_max_concurrency == 0 || m_executing < m_max_concurrency) {
+            ++m_executing;
+        } else {
+            if (m_waiting.size() >= m_max_queued) {
+                // Invocations whose callers have given up make room first.
+                for (auto itr = m_waiting.begin(); itr != m_waiting.end();) {
+                    if ((*itr)->expired()) {
+                        expired.push_back(*itr);
+                        itr = m_waiting.erase(itr);
+                    } else {
+                        ++itr;
+                    }
+                }
+            }
+
+            if (m_waiting.size() < m_max_queued) {
+                m_waiting.push_back(invocation);
+                queued = true;
+            } else {
+                rejected = true;
+            }
+        }
+    }
+
+    for (const wamp_invocation& waiting : expired) {
+        waiting->error(m_timeout_error);
+    }
+
+    if (queued) {
+        return;
+    }
+
+    if (rejected) {
+        // Answer right away rather than letting the caller wait behind the backlog.
+        invocation->error(m_overload_error);
+        return;
+    }
+
+    auto self = shared_from_this();
+    m_executor->post([self, invocation]() { self->execute(invocation); });
+}
+
+inline wamp_invocation_queue::execution_slot::execution_slot(
+        const std::shared_ptr<wamp_invocation_queue>& queue)
+    : m_queue(queue)
+{
+}
+
+inline wamp_invocation_queue::execution_slot::~execution_slot()
+{
+    m_queue->release_slot();
+}
+
+inline void wamp_invocation_queue::execute(wamp_invocation invocation)
+{
+    // The slot stays taken while the procedure works on the invocation, even
+    // after it returned, until the invocation is answered or dropped.
+    invocation->hold_until_answered(std::make_shared<execution_slot>(shared_from_this()));
+
+    try {
+        if (invocation->expired()) {
+            // The caller gave up while the invocation was waiting; running the
+            // procedure now would only delay the invocations behind it.
+            invocation->error(m_timeout_error);
+        } else {
+            m_procedure(invocation);
+        }
+    }
+
+    // FIXME: implement Autobahn-specific exception with error URI
+    catch (const std::exception& e) {
+        if (invocation->sendable()) {
+            std::map<std::string, std::string> error_kw_arguments;
+            error_kw_arguments["what"] = e.what();
+            invocation->error("wamp.error.runtime_error", EMPTY_ARGUMENTS, error_kw_arguments);
+        }
+    }
+    catch (...) {
+        if (invocation->sendable()) {
+            invocation->error("wamp.error.runtime_error");
+        }
+    }
+}
+
+inline void wamp_invocation_queue::release_slot()
+{
+    // The next waiting invocation is posted rather than run here so that other
+    // work on the executor gets its turn.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_waiting.empty()) {
+        --m_executing;
+    } else {
+        wamp_invocation next = m_waiting.front();
+        m_waiting.pop_front();
+
+        auto self = shared_from_this();
+        m_executor->post([self, next]() { self->execute(next); });
+    }
+}
+
+} // namespace autobahn
@@ -0,0 +1,134 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_KW_INDEX_HPP
+#define AUTOBAHN_WAMP_KW_INDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <msgpack.hpp>
+#include <string>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A keyword argument key with its hash computed up front, for look-ups that are
+ * repeated for many messages.
+ *
+ * Example:
+ * ```
+ * static const autobahn::wamp_kw_key PRICE("price");
+ * double price = event.kw_argument<double>(PRICE);
+ * ```
+ */
+class wamp_kw_key
+{
+public:
+    explicit wamp_kw_key(const char* key);
+    explicit wamp_kw_key(const std::string& key);
+
+    const char* data() const;
+    std::size_t size() const;
+    uint64_t hash() const;
+
+private:
+    std::string m_key;
+    uint64_t m_hash;
+};
+
+namespace detail {
+
+/// FNV-1a hash of a keyword argument key.
+uint64_t hash_kw_key(const char* key, std::size_t size);
+
+} // namespace detail
+
+/*!
+ * An open addressing hash table over the string keys of a msgpack map, pointing
+ * at the values in the map. The map must outlive the index.
+ */
+class wamp_kw_index
+{
+public:
+    /*!
+     * Index the entries of @p map, which must be of type MAP.
+     */
+    explicit wamp_kw_index(const msgpack::object& map);
+
+    /*!
+     * The value stored under @p key (of @p size octets and hash @p hash), or
+     * nullptr if there is none. Of duplicate keys the first one wins, as with a
+     * linear scan.
+     */
+    const msgpack::object* find(const char* key, std::size_t size, uint64_t hash) const;
+
+private:
+    struct slot
+    {
+        uint64_t hash;
+        const msgpack::object_kv* entry;
+    };
+
+    std::vector<slot> m_slots;
+    std::size_t m_mask;
+};
+
+/*!
+ * Keyword look-ups in one msgpack map of a received message. Small maps are
+ * scanned linearly; for maps with more than INDEX_THRESHOLD entries a
+ * wamp_kw_index is built with the first look-up and used from then on.
+ *
+ * Look-ups may happen on several threads at once.
+ */
+class wamp_kw_lookup
+{
+public:
+    /// Maps with more entries than this are indexed.
+    static const std::size_t INDEX_THRESHOLD = 16;
+
+    wamp_kw_lookup();
+    wamp_kw_lookup(const wamp_kw_lookup& other);
+    wamp_kw_lookup& operator=(const wamp_kw_lookup& other);
+
+    /*!
+     * The value stored under @p key in @p map, or nullptr if there is none.
+     * @p map must be the same map for all look-ups until reset() is called.
+     *
+     * @throw msgpack::type_error if @p map is not a map
+     */
+    const msgpack::object* find(const msgpack::object& map, const char* key, std::size_t size) const;
+
+    const msgpack::object* find(const msgpack::object& map, const wamp_kw_key& key) const;
+
+    /// Forget the index, for when the map looked up in changes.
+    void reset();
+
+private:
+    /// The index of @p map, built if it does not exist yet.
+    std::shared_ptr<const wamp_kw_index> index(const msgpack::object& map) const;
+
+    mutable std::shared_ptr<const wamp_kw_index> m_index;
+};
+
+} // namespace autobahn
+
+#include "wamp_kw_index.ipp"
+
+#endif // AUTOBAHN_WAMP_KW_INDEX_HPP
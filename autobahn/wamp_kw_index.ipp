@@ -0,0 +1,178 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+namespace autobahn {
+
+inline wamp_kw_key::wamp_kw_key(const char* key)
+    : m_key(key)
+    , m_hash(detail::hash_kw_key(m_key.data(), m_key.size()))
+{
+}
+
+inline wamp_kw_key::wamp_kw_key(const std::string& key)
+    : m_key(key)
+    , m_hash(detail::hash_kw_key(m_key.data(), m_key.size()))
+{
+}
+
+inline const char* wamp_kw_key::data() const
+{
+    return m_key.data();
+}
+
+inline std::size_t wamp_kw_key::size() const
+{
+    return m_key.size();
+}
+
+inline uint64_t wamp_kw_key::hash() const
+{
+    return m_hash;
+}
+
+namespace detail {
+
+inline uint64_t hash_kw_key(const char* key, std::size_t size)
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<unsigned char>(key[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+} // namespace detail
+
+inline wamp_kw_index::wamp_kw_index(const msgpack::object& map)
+    : m_slots()
+    , m_mask(0)
+{
+    // At most half of the slots are used, which keeps probe sequences short.
+    std::size_t capacity = 4;
+    while (capacity < 2 * static_cast<std::size_t>(map.via.map.size)) {
+        capacity *= 2;
+    }
+
+    slot empty = { 0, nullptr };
+    m_slots.assign(capacity, empty);
+    m_mask = capacity - 1;
+
+    for (std::size_t i = 0; i < map.via.map.size; ++i) {
+        const msgpack::object_kv& kv = map.via.map.ptr[i];
+        if (kv.key.type != msgpack::type::STR) {
+            continue;
+        }
+
+        uint64_t hash = detail::hash_kw_key(kv.key.via.str.ptr, kv.key.via.str.size);
+        std::size_t position = static_cast<std::size_t>(hash) & m_mask;
+        while (m_slots[position].entry) {
+            position = (position + 1) & m_mask;
+        }
+        m_slots[position].hash = hash;
+        m_slots[position].entry = &kv;
+    }
+}
+
+inline const msgpack::object* wamp_kw_index::find(const char* key, std::size_t size, uint64_t hash) const
+{
+    std::size_t position = static_cast<std::size_t>(hash) & m_mask;
+    while (m_slots[position].entry) {
+        const slot& candidate = m_slots[position];
+        if (candidate.hash == hash && candidate.entry->key.via.str.size == size
+                && memcmp(candidate.entry->key.via.str.ptr, key, size) == 0)
+        {
+            return &candidate.entry->val;
+        }
+        position = (position + 1) & m_mask;
+    }
+    return nullptr;
+}
+
+inline wamp_kw_lookup::wamp_kw_lookup()
+    : m_index()
+{
+}
+
+inline wamp_kw_lookup::wamp_kw_lookup(const wamp_kw_lookup& other)
+    : m_index(std::atomic_load(&other.m_index))
+{
+}
+
+inline wamp_kw_lookup& wamp_kw_lookup::operator=(const wamp_kw_lookup& other)
+{
+    if (this != &other) {
+        std::atomic_store(&m_index, std::atomic_load(&other.m_index));
+    }
+    return *this;
+}
+
+inline const msgpack::object* wamp_kw_lookup::find(
+        const msgpack::object& map, const char* key, std::size_t size) const
+{
+    if (map.type != msgpack::type::MAP) {
+        throw msgpack::type_error();
+    }
+
+    if (map.via.map.size > INDEX_THRESHOLD) {
+        return index(map)->find(key, size, detail::hash_kw_key(key, size));
+    }
+
+    for (std::size_t i = 0; i < map.via.map.size; ++i) {
+        const msgpack::object_kv& kv = map.via.map.ptr[i];
+        if (kv.key.type == msgpack::type::STR && size == kv.key.via.str.size
+                && memcmp(key, kv.key.via.str.ptr, size) == 0)
+        {
+            return &kv.val;
+        }
+    }
+    return nullptr;
+}
+
+inline const msgpack::object* wamp_kw_lookup::find(const msgpack::object& map, const wamp_kw_key& key) const
+{
+    if (map.type == msgpack::type::MAP && map.via.map.size > INDEX_THRESHOLD) {
+        return index(map)->find(key.data(), key.size(), key.hash());
+    }
+    return find(map, key.data(), key.size());
+}
+
+inline void wamp_kw_lookup::reset()
+{
+    std::atomic_store(&m_index, std::shared_ptr<const wamp_kw_index>());
+}
+
+inline std::shared_ptr<const wamp_kw_index> wamp_kw_lookup::index(const msgpack::object& map) const
+{
+    auto index = std::atomic_load(&m_index);
+    if (!index) {
+        // Threads racing here each build an index; one of them is kept.
+        std::shared_ptr<const wamp_kw_index> built = std::make_shared<wamp_kw_index>(map);
+        std::shared_ptr<const wamp_kw_index> expected;
+        if (std::atomic_compare_exchange_strong(&m_index, &expected, built)) {
+            index = built;
+        } else {
+            index = expected;
+        }
+    }
+    return index;
+}
+
+} // namespace autobahn
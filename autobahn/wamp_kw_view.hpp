@@ -0,0 +1,120 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_KW_VIEW_HPP
+#define AUTOBAHN_WAMP_KW_VIEW_HPP
+
+#include <boost/utility/string_ref.hpp>
+#include <cstddef>
+#include <msgpack.hpp>
+#include <utility>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A flat map of keyword arguments (or details) that refers to the message it was
+ * converted from instead of copying it.
+ *
+ * Keys are string references into the msgpack zone of the message and values are
+ * the msgpack objects of the message, so converting keyword arguments to a view
+ * takes a single allocation for the entries, where `std::unordered_map<std::string,
+ * msgpack::object>` allocates a node and a string per key. Entries are sorted by
+ * key and looked up with binary search. Of duplicate keys the first one is kept.
+ *
+ * A view is only valid as long as the event, call result or invocation it was
+ * converted from (or rather, the zone of its message) is alive. Views can be packed
+ * again, e.g. to forward keyword arguments with call() or result().
+ *
+ * Example:
+ * ```
+ * auto kw_args = invocation->kw_arguments<autobahn::wamp_kw_view>();
+ * auto itr = kw_args.find("price");
+ * ```
+ */
+class wamp_kw_view
+{
+public:
+    typedef std::pair<boost::string_ref, msgpack::object> value_type;
+    typedef std::vector<value_type>::const_iterator const_iterator;
+
+    wamp_kw_view();
+
+    /*!
+     * A view of the entries of @p map.
+     *
+     * @throw msgpack::type_error if @p map is not a map with string keys
+     */
+    explicit wamp_kw_view(const msgpack::object& map);
+
+    std::size_t size() const;
+    bool empty() const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /*!
+     * The entry with the given @p key, or end() if there is none.
+     */
+    const_iterator find(boost::string_ref key) const;
+
+    std::size_t count(boost::string_ref key) const;
+
+    /*!
+     * The value stored under @p key.
+     *
+     * @throw std::out_of_range
+     */
+    const msgpack::object& at(boost::string_ref key) const;
+
+    /*!
+     * Add or replace the entry for @p key. The view does not copy @p key or the
+     * data @p value refers to; both must outlive the view.
+     */
+    void set(boost::string_ref key, const msgpack::object& value);
+
+private:
+    std::vector<value_type> m_entries;
+};
+
+} // namespace autobahn
+
+namespace msgpack {
+MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) {
+namespace adaptor {
+
+template <>
+struct convert<autobahn::wamp_kw_view>
+{
+    const msgpack::object& operator()(const msgpack::object& object, autobahn::wamp_kw_view& view) const;
+};
+
+template <>
+struct pack<autobahn::wamp_kw_view>
+{
+    template <typename Stream>
+    msgpack::packer<Stream>& operator()(msgpack::packer<Stream>& packer, const autobahn::wamp_kw_view& view) const;
+};
+
+} // namespace adaptor
+} // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
+} // namespace msgpack
+
+#include "wamp_kw_view.ipp"
+
+#endif // AUTOBAHN_WAMP_KW_VIEW_HPP
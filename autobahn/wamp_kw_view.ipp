@@ -0,0 +1,155 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace autobahn {
+
+namespace detail {
+
+inline bool kw_view_key_less(const wamp_kw_view::value_type& entry, boost::string_ref key)
+{
+    return entry.first < key;
+}
+
+inline bool kw_view_entry_less(const wamp_kw_view::value_type& lhs, const wamp_kw_view::value_type& rhs)
+{
+    return lhs.first < rhs.first;
+}
+
+inline bool kw_view_entry_equal(const wamp_kw_view::value_type& lhs, const wamp_kw_view::value_type& rhs)
+{
+    return lhs.first == rhs.first;
+}
+
+} // namespace detail
+
+inline wamp_kw_view::wamp_kw_view()
+    : m_entries()
+{
+}
+
+inline wamp_kw_view::wamp_kw_view(const msgpack::object& map)
+    : m_entries()
+{
+    if (map.type != msgpack::type::MAP) {
+        throw msgpack::type_error();
+    }
+
+    m_entries.reserve(map.via.map.size);
+    for (std::size_t i = 0; i < map.via.map.size; ++i) {
+        const msgpack::object_kv& kv = map.via.map.ptr[i];
+        if (kv.key.type != msgpack::type::STR) {
+            throw msgpack::type_error();
+        }
+        m_entries.push_back(value_type(boost::string_ref(kv.key.via.str.ptr, kv.key.via.str.size), kv.val));
+    }
+
+    // A stable sort keeps duplicate keys in message order, so unique() keeps the first.
+    std::stable_sort(m_entries.begin(), m_entries.end(), detail::kw_view_entry_less);
+    m_entries.erase(
+            std::unique(m_entries.begin(), m_entries.end(), detail::kw_view_entry_equal),
+            m_entries.end());
+}
+
+inline std::size_t wamp_kw_view::size() const
+{
+    return m_entries.size();
+}
+
+inline bool wamp_kw_view::empty() const
+{
+    return m_entries.empty();
+}
+
+inline wamp_kw_view::const_iterator wamp_kw_view::begin() const
+{
+    return m_entries.begin();
+}
+
+inline wamp_kw_view::const_iterator wamp_kw_view::end() const
+{
+    return m_entries.end();
+}
+
+inline wamp_kw_view::const_iterator wamp_kw_view::find(boost::string_ref key) const
+{
+    auto itr = std::lower_bound(m_entries.begin(), m_entries.end(), key, detail::kw_view_key_less);
+    if (itr != m_entries.end() && itr->first == key) {
+        return itr;
+    }
+    return m_entries.end();
+}
+
+inline std::size_t wamp_kw_view::count(boost::string_ref key) const
+{
+    return find(key) == end() ? 0 : 1;
+}
+
+inline const msgpack::object& wamp_kw_view::at(boost::string_ref key) const
+{
+    auto itr = find(key);
+    if (itr == end()) {
+        throw std::out_of_range(std::string(key.data(), key.size()) + " keyword argument doesn't exist");
+    }
+    return itr->second;
+}
+
+inline void wamp_kw_view::set(boost::string_ref key, const msgpack::object& value)
+{
+    auto itr = std::lower_bound(m_entries.begin(), m_entries.end(), key, detail::kw_view_key_less);
+    if (itr != m_entries.end() && itr->first == key) {
+        itr->second = value;
+    } else {
+        m_entries.insert(itr, value_type(key, value));
+    }
+}
+
+} // namespace autobahn
+
+namespace msgpack {
+MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) {
+namespace adaptor {
+
+inline const msgpack::object& convert<autobahn::wamp_kw_view>::operator()(
+        const msgpack::object& object, autobahn::wamp_kw_view& view) const
+{
+    view = autobahn::wamp_kw_view(object);
+    return object;
+}
+
+template <typename Stream>
+msgpack::packer<Stream>& pack<autobahn::wamp_kw_view>::operator()(
+        msgpack::packer<Stream>& packer, const autobahn::wamp_kw_view& view) const
+{
+    packer.pack_map(static_cast<uint32_t>(view.size()));
+    for (const auto& entry : view) {
+        packer.pack_str(static_cast<uint32_t>(entry.first.size()));
+        packer.pack_str_body(entry.first.data(), static_cast<uint32_t>(entry.first.size()));
+        packer.pack(entry.second);
+    }
+
+    return packer;
+}
+
+} // namespace adaptor
+} // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
+} // namespace msgpack
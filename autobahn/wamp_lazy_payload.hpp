@@ -0,0 +1,152 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_LAZY_PAYLOAD_HPP
+#define AUTOBAHN_WAMP_LAZY_PAYLOAD_HPP
+
+#include "wamp_kw_index.hpp"
+#include "wamp_msgpack_cursor.hpp"
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <msgpack.hpp>
+#include <mutex>
+
+namespace autobahn {
+
+/*!
+ * The positional and keyword arguments of a received message, kept as msgpack
+ * encoded bytes and decoded on access.
+ *
+ * Looking up a single argument decodes only that argument, skipping over the
+ * bytes of the others. Accessing all arguments at once decodes them once. Either
+ * way the result is kept for later accesses, so repeated lookups do not grow the
+ * payload. Decoded objects live in a zone owned
+ * by the payload, so they stay valid for as long as the payload exists.
+ *
+ * A payload may be accessed from several threads.
+ */
+class wamp_lazy_payload
+{
+public:
+    /*!
+     * A payload over the encoded @p arguments and @p kw_arguments, which are kept
+     * alive by @p zone. Either span may be empty if the message had no such
+     * arguments.
+     */
+    wamp_lazy_payload(
+            const std::shared_ptr<msgpack::zone>& zone,
+            const wamp_msgpack_span& arguments,
+            const wamp_msgpack_span& kw_arguments);
+
+    /// The encoded positional arguments, empty if there are none.
+    const wamp_msgpack_span& raw_arguments() const;
+
+    /// The encoded keyword arguments, empty if there are none.
+    const wamp_msgpack_span& raw_kw_arguments() const;
+
+    std::size_t number_of_arguments() const;
+
+    std::size_t number_of_kw_arguments() const;
+
+    /*!
+     * The positional argument at @p index.
+     *
+     * @throw std::out_of_range
+     */
+    msgpack::object argument(std::size_t index) const;
+
+    /*!
+     * The keyword argument @p key, or nullptr if there is none. The object stays
+     * valid for as long as the payload exists.
+     */
+    const msgpack::object* find_kw_argument(const char* key, std::size_t key_size) const;
+
+    /// All positional arguments, decoded on the first call.
+    const msgpack::object& arguments() const;
+
+    /// All keyword arguments, decoded on the first call.
+    const msgpack::object& kw_arguments() const;
+
+private:
+    /// Decode @p span into m_decoded. Requires m_mutex to be locked.
+    msgpack::object decode(const wamp_msgpack_span& span) const;
+
+    /// Decode the single argument @p element, or return its earlier decoding.
+    /// Requires m_mutex to be locked.
+    const msgpack::object& decode_element(const wamp_msgpack_span& element) const;
+
+    /// Zone holding the encoded arguments.
+    std::shared_ptr<msgpack::zone> m_zone;
+
+    wamp_msgpack_span m_arguments;
+    wamp_msgpack_span m_kw_arguments;
+
+    mutable std::mutex m_mutex;
+
+    /// Zone of decoded objects, created with the first decoding.
+    mutable std::unique_ptr<msgpack::zone> m_decoded;
+
+    /// Single arguments decoded so far, by the position of their encoding.
+    mutable std::map<const char*, msgpack::object> m_decoded_elements;
+
+    /// All positional and keyword arguments, once decoded.
+    mutable msgpack::object m_all_arguments;
+    mutable msgpack::object m_all_kw_arguments;
+    mutable bool m_all_arguments_decoded;
+    mutable bool m_all_kw_arguments_decoded;
+};
+
+namespace detail {
+
+/*!
+ * The keyword argument @p key (of @p size octets) of a received message, or
+ * nullptr if there is none. It is looked up in @p payload if the message keeps
+ * its payload encoded, and in @p map through @p lookup otherwise.
+ */
+const msgpack::object* find_kw_argument(
+        const std::shared_ptr<wamp_lazy_payload>& payload, const wamp_kw_lookup& lookup,
+        const msgpack::object& map, const char* key, std::size_t size);
+
+/// As above, using the precomputed hash of @p key for indexed maps.
+const msgpack::object* find_kw_argument(
+        const std::shared_ptr<wamp_lazy_payload>& payload, const wamp_kw_lookup& lookup,
+        const msgpack::object& map, const wamp_kw_key& key);
+
+/*!
+ * The keyword argument @p key (of @p size octets) of a received message, see
+ * find_kw_argument().
+ *
+ * @throw std::out_of_range if there is none
+ */
+const msgpack::object& require_kw_argument(
+        const std::shared_ptr<wamp_lazy_payload>& payload, const wamp_kw_lookup& lookup,
+        const msgpack::object& map, const char* key, std::size_t size);
+
+const msgpack::object& require_kw_argument(
+        const std::shared_ptr<wamp_lazy_payload>& payload, const wamp_kw_lookup& lookup,
+        const msgpack::object& map, const wamp_kw_key& key);
+
+} // namespace detail
+
+} // namespace autobahn
+
+#include "wamp_lazy_payload.ipp"
+
+#endif // AUTOBAHN_WAMP_LAZY_PAYLOAD_HPP
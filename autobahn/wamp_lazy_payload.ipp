@@ -0,0 +1,173 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "wamp_arguments.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace autobahn {
+
+inline wamp_lazy_payload::wamp_lazy_payload(
+        const std::shared_ptr<msgpack::zone>& zone,
+        const wamp_msgpack_span& arguments,
+        const wamp_msgpack_span& kw_arguments)
+    : m_zone(zone)
+    , m_arguments(arguments)
+    , m_kw_arguments(kw_arguments)
+    , m_mutex()
+    , m_decoded()
+    , m_decoded_elements()
+    , m_all_arguments(EMPTY_ARGUMENTS)
+    , m_all_kw_arguments(EMPTY_KW_ARGUMENTS)
+    , m_all_arguments_decoded(arguments.empty())
+    , m_all_kw_arguments_decoded(kw_arguments.empty())
+{
+}
+
+inline const wamp_msgpack_span& wamp_lazy_payload::raw_arguments() const
+{
+    return m_arguments;
+}
+
+inline const wamp_msgpack_span& wamp_lazy_payload::raw_kw_arguments() const
+{
+    return m_kw_arguments;
+}
+
+inline std::size_t wamp_lazy_payload::number_of_arguments() const
+{
+    return m_arguments.empty() ? 0 : wamp_msgpack_cursor(m_arguments).size();
+}
+
+inline std::size_t wamp_lazy_payload::number_of_kw_arguments() const
+{
+    return m_kw_arguments.empty() ? 0 : wamp_msgpack_cursor(m_kw_arguments).size();
+}
+
+inline msgpack::object wamp_lazy_payload::argument(std::size_t index) const
+{
+    if (m_arguments.empty()) {
+        throw std::out_of_range("no argument at index " + std::to_string(index));
+    }
+
+    wamp_msgpack_span element = wamp_msgpack_cursor(m_arguments).element(index);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return decode_element(element);
+}
+
+inline const msgpack::object* wamp_lazy_payload::find_kw_argument(const char* key, std::size_t key_size) const
+{
+    if (m_kw_arguments.empty()) {
+        return nullptr;
+    }
+
+    wamp_msgpack_span element = wamp_msgpack_cursor(m_kw_arguments).find(key, key_size);
+    if (element.empty()) {
+        return nullptr;
+    }
+
+    // Decoded elements are never dropped, so the object outlives the lock.
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return &decode_element(element);
+}
+
+inline const msgpack::object& wamp_lazy_payload::arguments() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_all_arguments_decoded) {
+        m_all_arguments = decode(m_arguments);
+        m_all_arguments_decoded = true;
+    }
+    return m_all_arguments;
+}
+
+inline const msgpack::object& wamp_lazy_payload::kw_arguments() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_all_kw_arguments_decoded) {
+        m_all_kw_arguments = decode(m_kw_arguments);
+        m_all_kw_arguments_decoded = true;
+    }
+    return m_all_kw_arguments;
+}
+
+inline msgpack::object wamp_lazy_payload::decode(const wamp_msgpack_span& span) const
+{
+    if (!m_decoded) {
+        m_decoded.reset(new msgpack::zone());
+    }
+
+    // Strings and binaries are referenced rather than copied; m_zone keeps them alive.
+    auto reference_all = [](msgpack::type::object_type, std::size_t, void*) { return true; };
+
+    std::size_t offset = 0;
+    return msgpack::unpack(*m_decoded, span.data(), span.size(), offset, reference_all);
+}
+
+inline const msgpack::object& wamp_lazy_payload::decode_element(const wamp_msgpack_span& element) const
+{
+    auto decoded_itr = m_decoded_elements.find(element.data());
+    if (decoded_itr == m_decoded_elements.end()) {
+        decoded_itr = m_decoded_elements.emplace(element.data(), decode(element)).first;
+    }
+    return decoded_itr->second;
+}
+
+namespace detail {
+
+inline const msgpack::object* find_kw_argument(
+        const std::shared_ptr<wamp_lazy_payload>& payload, const wamp_kw_lookup& lookup,
+        const msgpack::object& map, const char* key, std::size_t size)
+{
+    return payload ? payload->find_kw_argument(key, size) : lookup.find(map, key, size);
+}
+
+inline const msgpack::object* find_kw_argument(
+        const std::shared_ptr<wamp_lazy_payload>& payload, const wamp_kw_lookup& lookup,
+        const msgpack::object& map, const wamp_kw_key& key)
+{
+    return payload ? payload->find_kw_argument(key.data(), key.size()) : lookup.find(map, key);
+}
+
+inline const msgpack::object& require_kw_argument(
+        const std::shared_ptr<wamp_lazy_payload>& payload, const wamp_kw_lookup& lookup,
+        const msgpack::object& map, const char* key, std::size_t size)
+{
+    const msgpack::object* value = find_kw_argument(payload, lookup, map, key, size);
+    if (!value) {
+        throw std::out_of_range(std::string(key, size) + " keyword argument doesn't exist");
+    }
+    return *value;
+}
+
+inline const msgpack::object& require_kw_argument(
+        const std::shared_ptr<wamp_lazy_payload>& payload, const wamp_kw_lookup& lookup,
+        const msgpack::object& map, const wamp_kw_key& key)
+{
+    const msgpack::object* value = find_kw_argument(payload, lookup, map, key);
+    if (!value) {
+        throw std::out_of_range(std::string(key.data(), key.size()) + " keyword argument doesn't exist");
+    }
+    return *value;
+}
+
+} // namespace detail
+
+} // namespace autobahn
@@ -19,6 +19,7 @@
 #ifndef AUTOBAHN_WAMP_MESSAGE_HPP
 #define AUTOBAHN_WAMP_MESSAGE_HPP
 
+#include <cstring>
 #include <msgpack.hpp>
 #include <vector>
 
@@ -26,6 +27,28 @@ namespace autobahn {
 
 typedef std::vector<msgpack::object> wamp_message;
 
+/*!
+ * The value of @p key in a Details or Options dictionary of a message, or null
+ * if the dictionary has no such key.
+ */
+inline const msgpack::object* find_detail(const msgpack::object& details, const char* key)
+{
+    if (details.type != msgpack::type::MAP) {
+        return nullptr;
+    }
+
+    std::size_t length = std::strlen(key);
+    for (uint32_t i = 0; i < details.via.map.size; ++i) {
+        const msgpack::object& name = details.via.map.ptr[i].key;
+        if (name.type == msgpack::type::STR && name.via.str.size == length &&
+                std::memcmp(name.via.str.ptr, key, length) == 0) {
+            return &details.via.map.ptr[i].val;
+        }
+    }
+
+    return nullptr;
+}
+
 } // namespace autobahn
 
 #endif // AUTOBAHN_WAMP_MESSAGE_HPP
@@ -0,0 +1,68 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_MESSAGE_VALIDATOR_HPP
+#define AUTOBAHN_WAMP_MESSAGE_VALIDATOR_HPP
+
+#include "wamp_message_type.hpp"
+#include "wamp_msgpack_cursor.hpp"
+
+#include <cstddef>
+
+namespace autobahn {
+
+namespace detail {
+
+/*!
+ * The envelope of a WAMP message: the number of elements it may have and the
+ * types of the elements following the message code.
+ */
+struct wamp_message_shape
+{
+    message_type code;
+    const char* name;
+    std::size_t min_size;
+    std::size_t max_size;
+
+    /// One character per element after the code: 'i' for an id or integer, 'd' for a
+    /// dictionary, 's' for a string and 'l' for a list. Null for messages a client
+    /// never accepts, which are rejected by their code later on.
+    const char* fields;
+};
+
+/// The shape of messages with the given @p code, or nullptr for unknown codes.
+const wamp_message_shape* find_message_shape(uint64_t code);
+
+/*!
+ * Check the message at @p offset of the @p size octets at @p data without
+ * unpacking it: that it is well-formed msgpack and that its envelope (length,
+ * message code and the types of the fields up to the payload) has the shape
+ * the message code requires.
+ *
+ * \return The offset following the message.
+ * @throw protocol_error
+ */
+std::size_t validate_wamp_message(const char* data, std::size_t size, std::size_t offset);
+
+} // namespace detail
+
+} // namespace autobahn
+
+#include "wamp_message_validator.ipp"
+
+#endif // AUTOBAHN_WAMP_MESSAGE_VALIDATOR_HPP
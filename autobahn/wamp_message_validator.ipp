@@ -0,0 +1,125 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <string>
+
+namespace autobahn {
+
+namespace detail {
+
+inline const wamp_message_shape* find_message_shape(uint64_t code)
+{
+    static const wamp_message_shape shapes[] = {
+        { message_type::HELLO, "HELLO", 1, 0, nullptr },
+        { message_type::WELCOME, "WELCOME", 3, 3, "id" },
+        { message_type::ABORT, "ABORT", 3, 3, "ds" },
+        { message_type::CHALLENGE, "CHALLENGE", 3, 3, "sd" },
+        { message_type::AUTHENTICATE, "AUTHENTICATE", 1, 0, nullptr },
+        { message_type::GOODBYE, "GOODBYE", 3, 3, "ds" },
+        { message_type::HEARTBEAT, "HEARTBEAT", 1, 0, nullptr },
+        { message_type::ERROR, "ERROR", 5, 7, "iidsld" },
+        { message_type::PUBLISH, "PUBLISH", 1, 0, nullptr },
+        { message_type::PUBLISHED, "PUBLISHED", 3, 3, "ii" },
+        { message_type::SUBSCRIBE, "SUBSCRIBE", 1, 0, nullptr },
+        { message_type::SUBSCRIBED, "SUBSCRIBED", 3, 3, "ii" },
+        { message_type::UNSUBSCRIBE, "UNSUBSCRIBE", 1, 0, nullptr },
+        { message_type::UNSUBSCRIBED, "UNSUBSCRIBED", 2, 2, "i" },
+        { message_type::EVENT, "EVENT", 4, 6, "iidld" },
+        { message_type::CALL, "CALL", 1, 0, nullptr },
+        { message_type::CANCEL, "CANCEL", 1, 0, nullptr },
+        { message_type::RESULT, "RESULT", 3, 5, "idld" },
+        { message_type::REGISTER, "REGISTER", 1, 0, nullptr },
+        { message_type::REGISTERED, "REGISTERED", 3, 3, "ii" },
+        { message_type::UNREGISTER, "UNREGISTER", 1, 0, nullptr },
+        { message_type::UNREGISTERED, "UNREGISTERED", 2, 2, "i" },
+        { message_type::INVOCATION, "INVOCATION", 4, 6, "iidld" },
+        { message_type::INTERRUPT, "INTERRUPT", 3, 3, "id" },
+        { message_type::YIELD, "YIELD", 1, 0, nullptr }
+    };
+
+    for (const wamp_message_shape& shape : shapes) {
+        if (static_cast<uint64_t>(shape.code) == code) {
+            return &shape;
+        }
+    }
+    return nullptr;
+}
+
+inline std::size_t validate_wamp_message(const char* data, std::size_t size, std::size_t offset)
+{
+    msgpack_header message = read_msgpack_header(data, size, offset);
+    if (message.type != msgpack::type::ARRAY) {
+        throw protocol_error("invalid message structure - message is not an array");
+    }
+    if (message.children < 1) {
+        throw protocol_error("invalid message structure - missing message code");
+    }
+
+    // Each element is skipped exactly once, which checks that it is well-formed and
+    // complete, so length fields claiming more elements or octets than were
+    // received never reach the unpacker.
+    std::size_t position = offset + message.header_size;
+    const std::size_t code_position = position;
+    msgpack_header code_header = read_msgpack_header(data, size, code_position);
+    position = skip_msgpack_element(data, size, code_position);
+    if (code_header.type != msgpack::type::POSITIVE_INTEGER) {
+        throw protocol_error("invalid message code type - not an integer");
+    }
+
+    // The unsigned and the (non-negative) signed formats both store the value big endian
+    // after the format byte.
+    uint64_t code = code_header.body_size == 0
+            ? static_cast<unsigned char>(data[code_position])
+            : read_msgpack_length(data + code_position + 1, code_header.body_size);
+    const wamp_message_shape* shape = find_message_shape(code);
+    if (!shape) {
+        throw protocol_error("invalid message code - unknown message type " + std::to_string(code));
+    }
+
+    if (shape->fields && (message.children < shape->min_size || message.children > shape->max_size)) {
+        throw protocol_error(std::string("invalid ") + shape->name + " message structure - length must be "
+                + std::to_string(shape->min_size)
+                + (shape->min_size == shape->max_size ? "" : " to " + std::to_string(shape->max_size)));
+    }
+
+    for (uint64_t i = 1; i < message.children; ++i) {
+        if (shape->fields) {
+            msgpack::type::object_type expected;
+            const char* description;
+            switch (shape->fields[i - 1]) {
+                case 'i': expected = msgpack::type::POSITIVE_INTEGER; description = "an integer"; break;
+                case 'd': expected = msgpack::type::MAP; description = "a dictionary"; break;
+                case 's': expected = msgpack::type::STR; description = "a string"; break;
+                default: expected = msgpack::type::ARRAY; description = "a list"; break;
+            }
+
+            if (read_msgpack_header(data, size, position).type != expected) {
+                throw protocol_error(std::string("invalid ") + shape->name + " message structure - element "
+                        + std::to_string(i) + " must be " + description);
+            }
+        }
+
+        position = skip_msgpack_element(data, size, position);
+    }
+
+    return position;
+}
+
+} // namespace detail
+
+} // namespace autobahn
@@ -0,0 +1,142 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_MSGPACK_CURSOR_HPP
+#define AUTOBAHN_WAMP_MSGPACK_CURSOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <msgpack.hpp>
+#include <stdexcept>
+#include <string>
+
+#include "exceptions.hpp"
+
+namespace autobahn {
+
+/*!
+ * A non-owning view of the bytes of msgpack encoded data.
+ */
+class wamp_msgpack_span
+{
+public:
+    wamp_msgpack_span();
+    wamp_msgpack_span(const char* data, std::size_t size);
+
+    const char* data() const;
+    std::size_t size() const;
+    bool empty() const;
+
+private:
+    const char* m_data;
+    std::size_t m_size;
+};
+
+namespace detail {
+
+/// The header of one msgpack encoded element.
+struct msgpack_header
+{
+    msgpack::type::object_type type;
+
+    /// Octets of the format byte and the length fields.
+    std::size_t header_size;
+
+    /// Octets following the header that belong to the element itself: the bytes of
+    /// a string, binary or extension (including its type byte) or of a scalar value.
+    std::size_t body_size;
+
+    /// Elements nested directly in the element: the items of an array, the keys
+    /// and values of a map.
+    uint64_t children;
+};
+
+/*!
+ * Read the header of the element at @p offset of @p data.
+ *
+ * @throw protocol_error if the data ends within the header or its format byte is invalid
+ */
+msgpack_header read_msgpack_header(const char* data, std::size_t size, std::size_t offset);
+
+/*!
+ * Skip the element at @p offset of @p data, including everything nested in it,
+ * without decoding it.
+ *
+ * \return The offset following the element.
+ * @throw protocol_error if the element is malformed or truncated
+ */
+std::size_t skip_msgpack_element(const char* data, std::size_t size, std::size_t offset);
+
+} // namespace detail
+
+/*!
+ * Navigates msgpack encoded data without decoding it.
+ *
+ * A cursor is positioned on one element. For arrays and maps it finds nested
+ * elements by skipping over their predecessors, so the cost of a look-up depends
+ * on the encoded size of the elements in front of the one looked for, but nothing
+ * is allocated or decoded on the way. Map keys are compared in their encoded form.
+ */
+class wamp_msgpack_cursor
+{
+public:
+    /*!
+     * A cursor on the first element of @p span.
+     *
+     * @throw protocol_error if the span does not start with a complete element header
+     */
+    explicit wamp_msgpack_cursor(const wamp_msgpack_span& span);
+
+    msgpack::type::object_type type() const;
+
+    /*!
+     * The number of items of an array or of key/value pairs of a map, zero for
+     * other types.
+     */
+    std::size_t size() const;
+
+    /*!
+     * The bytes of the item at @p index of an array.
+     *
+     * @throw msgpack::type_error if the element is not an array
+     * @throw std::out_of_range
+     */
+    wamp_msgpack_span element(std::size_t index) const;
+
+    /*!
+     * The bytes of the value stored under the string @p key of a map, or an empty
+     * span if the map has no such key.
+     *
+     * @throw msgpack::type_error if the element is not a map
+     */
+    wamp_msgpack_span find(const char* key, std::size_t key_size) const;
+
+    wamp_msgpack_span find(const std::string& key) const;
+
+    wamp_msgpack_span find(const char* key) const;
+
+private:
+    wamp_msgpack_span m_span;
+    detail::msgpack_header m_header;
+};
+
+} // namespace autobahn
+
+#include "wamp_msgpack_cursor.ipp"
+
+#endif // AUTOBAHN_WAMP_MSGPACK_CURSOR_HPP
@@ -0,0 +1,256 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+
+namespace autobahn {
+
+inline wamp_msgpack_span::wamp_msgpack_span()
+    : m_data(nullptr)
+    , m_size(0)
+{
+}
+
+inline wamp_msgpack_span::wamp_msgpack_span(const char* data, std::size_t size)
+    : m_data(data)
+    , m_size(size)
+{
+}
+
+inline const char* wamp_msgpack_span::data() const
+{
+    return m_data;
+}
+
+inline std::size_t wamp_msgpack_span::size() const
+{
+    return m_size;
+}
+
+inline bool wamp_msgpack_span::empty() const
+{
+    return m_size == 0;
+}
+
+namespace detail {
+
+/// Read a big endian unsigned integer of @p octets octets.
+inline uint64_t read_msgpack_length(const char* data, std::size_t octets)
+{
+    uint64_t value = 0;
+    for (std::size_t i = 0; i < octets; ++i) {
+        value = (value << 8) | static_cast<unsigned char>(data[i]);
+    }
+    return value;
+}
+
+inline msgpack_header read_msgpack_header(const char* data, std::size_t size, std::size_t offset)
+{
+    if (offset >= size) {
+        throw protocol_error("msgpack data truncated");
+    }
+
+    const unsigned char format = static_cast<unsigned char>(data[offset]);
+    msgpack_header header = { msgpack::type::NIL, 1, 0, 0 };
+
+    // Formats with a fixed size: the octets of a scalar or of a length field.
+    std::size_t length_size = 0;
+
+    if (format <= 0x7f) {
+        header.type = msgpack::type::POSITIVE_INTEGER;
+    } else if (format <= 0x8f) {
+        header.type = msgpack::type::MAP;
+        header.children = 2 * static_cast<uint64_t>(format & 0x0f);
+    } else if (format <= 0x9f) {
+        header.type = msgpack::type::ARRAY;
+        header.children = format & 0x0f;
+    } else if (format <= 0xbf) {
+        header.type = msgpack::type::STR;
+        header.body_size = format & 0x1f;
+    } else if (format >= 0xe0) {
+        header.type = msgpack::type::NEGATIVE_INTEGER;
+    } else {
+        switch (format) {
+            case 0xc0: header.type = msgpack::type::NIL; break;
+            case 0xc2: case 0xc3: header.type = msgpack::type::BOOLEAN; break;
+            case 0xc4: header.type = msgpack::type::BIN; length_size = 1; break;
+            case 0xc5: header.type = msgpack::type::BIN; length_size = 2; break;
+            case 0xc6: header.type = msgpack::type::BIN; length_size = 4; break;
+            case 0xc7: header.type = msgpack::type::EXT; length_size = 1; break;
+            case 0xc8: header.type = msgpack::type::EXT; length_size = 2; break;
+            case 0xc9: header.type = msgpack::type::EXT; length_size = 4; break;
+            case 0xca: header.type = msgpack::type::FLOAT; header.body_size = 4; break;
+            case 0xcb: header.type = msgpack::type::FLOAT; header.body_size = 8; break;
+            case 0xcc: header.type = msgpack::type::POSITIVE_INTEGER; header.body_size = 1; break;
+            case 0xcd: header.type = msgpack::type::POSITIVE_INTEGER; header.body_size = 2; break;
+            case 0xce: header.type = msgpack::type::POSITIVE_INTEGER; header.body_size = 4; break;
+            case 0xcf: header.type = msgpack::type::POSITIVE_INTEGER; header.body_size = 8; break;
+            case 0xd0: header.type = msgpack::type::NEGATIVE_INTEGER; header.body_size = 1; break;
+            case 0xd1: header.type = msgpack::type::NEGATIVE_INTEGER; header.body_size = 2; break;
+            case 0xd2: header.type = msgpack::type::NEGATIVE_INTEGER; header.body_size = 4; break;
+            case 0xd3: header.type = msgpack::type::NEGATIVE_INTEGER; header.body_size = 8; break;
+            case 0xd4: header.type = msgpack::type::EXT; header.body_size = 2; break;
+            case 0xd5: header.type = msgpack::type::EXT; header.body_size = 3; break;
+            case 0xd6: header.type = msgpack::type::EXT; header.body_size = 5; break;
+            case 0xd7: header.type = msgpack::type::EXT; header.body_size = 9; break;
+            case 0xd8: header.type = msgpack::type::EXT; header.body_size = 17; break;
+            case 0xd9: header.type = msgpack::type::STR; length_size = 1; break;
+            case 0xda: header.type = msgpack::type::STR; length_size = 2; break;
+            case 0xdb: header.type = msgpack::type::STR; length_size = 4; break;
+            case 0xdc: header.type = msgpack::type::ARRAY; length_size = 2; break;
+            case 0xdd: header.type = msgpack::type::ARRAY; length_size = 4; break;
+            case 0xde: header.type = msgpack::type::MAP; length_size = 2; break;
+            case 0xdf: header.type = msgpack::type::MAP; length_size = 4; break;
+            default:
+                throw protocol_error("invalid msgpack format byte");
+        }
+    }
+
+    // Like msgpack-c, classify a non-negative value in a signed format as a positive
+    // integer. Encoders in other languages often pick the signed formats for ids.
+    if (format >= 0xd0 && format <= 0xd3 && size - offset > 1
+            && (static_cast<unsigned char>(data[offset + 1]) & 0x80) == 0)
+    {
+        header.type = msgpack::type::POSITIVE_INTEGER;
+    }
+
+    if (length_size == 0) {
+        return header;
+    }
+
+    if (size - offset - 1 < length_size) {
+        throw protocol_error("msgpack data truncated");
+    }
+
+    uint64_t length = read_msgpack_length(data + offset + 1, length_size);
+    header.header_size += length_size;
+
+    switch (header.type) {
+        case msgpack::type::ARRAY:
+            header.children = length;
+            break;
+        case msgpack::type::MAP:
+            header.children = 2 * length;
+            break;
+        case msgpack::type::EXT:
+            // the extension type byte follows the length
+            header.body_size = static_cast<std::size_t>(length) + 1;
+            break;
+        default:
+            header.body_size = static_cast<std::size_t>(length);
+            break;
+    }
+
+    return header;
+}
+
+inline std::size_t skip_msgpack_element(const char* data, std::size_t size, std::size_t offset)
+{
+    // Elements still to skip, including the nested ones discovered on the way.
+    uint64_t pending = 1;
+
+    while (pending > 0) {
+        msgpack_header header = read_msgpack_header(data, size, offset);
+        if (size - offset < header.header_size || size - offset - header.header_size < header.body_size) {
+            throw protocol_error("msgpack data truncated");
+        }
+
+        offset += header.header_size + header.body_size;
+        pending += header.children - 1;
+    }
+
+    return offset;
+}
+
+} // namespace detail
+
+inline wamp_msgpack_cursor::wamp_msgpack_cursor(const wamp_msgpack_span& span)
+    : m_span(span)
+    , m_header(detail::read_msgpack_header(span.data(), span.size(), 0))
+{
+}
+
+inline msgpack::type::object_type wamp_msgpack_cursor::type() const
+{
+    return m_header.type;
+}
+
+inline std::size_t wamp_msgpack_cursor::size() const
+{
+    if (m_header.type == msgpack::type::MAP) {
+        return static_cast<std::size_t>(m_header.children / 2);
+    }
+    return m_header.type == msgpack::type::ARRAY ? static_cast<std::size_t>(m_header.children) : 0;
+}
+
+inline wamp_msgpack_span wamp_msgpack_cursor::element(std::size_t index) const
+{
+    if (m_header.type != msgpack::type::ARRAY) {
+        throw msgpack::type_error();
+    }
+    if (index >= m_header.children) {
+        throw std::out_of_range("no element at index " + std::to_string(index));
+    }
+
+    std::size_t offset = m_header.header_size;
+    for (std::size_t i = 0; i < index; ++i) {
+        offset = detail::skip_msgpack_element(m_span.data(), m_span.size(), offset);
+    }
+
+    std::size_t end = detail::skip_msgpack_element(m_span.data(), m_span.size(), offset);
+    return wamp_msgpack_span(m_span.data() + offset, end - offset);
+}
+
+inline wamp_msgpack_span wamp_msgpack_cursor::find(const char* key, std::size_t key_size) const
+{
+    if (m_header.type != msgpack::type::MAP) {
+        throw msgpack::type_error();
+    }
+
+    const char* data = m_span.data();
+    const std::size_t size = m_span.size();
+    std::size_t offset = m_header.header_size;
+
+    for (uint64_t i = 0; i < m_header.children; i += 2) {
+        detail::msgpack_header key_header = detail::read_msgpack_header(data, size, offset);
+        std::size_t value_offset = detail::skip_msgpack_element(data, size, offset);
+
+        bool matches = key_header.type == msgpack::type::STR
+                && key_header.body_size == key_size
+                && memcmp(data + offset + key_header.header_size, key, key_size) == 0;
+
+        offset = detail::skip_msgpack_element(data, size, value_offset);
+        if (matches) {
+            return wamp_msgpack_span(data + value_offset, offset - value_offset);
+        }
+    }
+
+    return wamp_msgpack_span();
+}
+
+inline wamp_msgpack_span wamp_msgpack_cursor::find(const std::string& key) const
+{
+    return find(key.data(), key.size());
+}
+
+inline wamp_msgpack_span wamp_msgpack_cursor::find(const char* key) const
+{
+    return find(key, strlen(key));
+}
+
+} // namespace autobahn
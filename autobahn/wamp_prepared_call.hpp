@@ -0,0 +1,64 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_PREPARED_CALL_HPP
+#define AUTOBAHN_WAMP_PREPARED_CALL_HPP
+
+#include "wamp_call_options.hpp"
+
+#include <memory>
+#include <msgpack.hpp>
+#include <string>
+
+namespace autobahn {
+
+/*!
+ * A procedure to call repeatedly, with its options and URI serialized once.
+ *
+ * Calls through the handle only serialize the message header and their
+ * arguments. Handles are cheap to copy and can be shared between threads.
+ *
+ * \see wamp_session::prepare_call
+ */
+class wamp_prepared_call
+{
+public:
+    wamp_prepared_call(const std::string& procedure,
+            const wamp_call_options& options = wamp_call_options());
+
+    /*!
+     * The options of calls through this handle.
+     */
+    const wamp_call_options& options() const;
+
+    //
+    // functions only called internally by wamp_session
+
+    /// The serialized CALL.Options and CALL.Procedure.
+    const msgpack::sbuffer& encoded() const;
+
+private:
+    wamp_call_options m_options;
+    std::shared_ptr<msgpack::sbuffer> m_encoded;
+};
+
+} // namespace autobahn
+
+#include "wamp_prepared_call.ipp"
+
+#endif // AUTOBAHN_WAMP_PREPARED_CALL_HPP
@@ -0,0 +1,41 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_prepared_call::wamp_prepared_call(
+        const std::string& procedure, const wamp_call_options& options)
+    : m_options(options)
+    , m_encoded(std::make_shared<msgpack::sbuffer>(procedure.size() + 32))
+{
+    msgpack::packer<msgpack::sbuffer> packer(*m_encoded);
+    packer.pack(options);
+    packer.pack(procedure);
+}
+
+inline const wamp_call_options& wamp_prepared_call::options() const
+{
+    return m_options;
+}
+
+inline const msgpack::sbuffer& wamp_prepared_call::encoded() const
+{
+    return *m_encoded;
+}
+
+} // namespace autobahn
@@ -0,0 +1,67 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_PREPARED_TOPIC_HPP
+#define AUTOBAHN_WAMP_PREPARED_TOPIC_HPP
+
+#include "wamp_arguments.hpp"
+
+#include <memory>
+#include <msgpack.hpp>
+#include <string>
+
+namespace autobahn {
+
+/// Options sent with PUBLISH messages, see wamp_prepared_topic.
+using publish_options = wamp_kw_arguments;
+
+/*!
+ * A topic to publish to repeatedly, with its options and URI serialized once.
+ *
+ * Publishing through the handle only serializes the message header and the
+ * payload. Handles are cheap to copy and can be shared between threads.
+ *
+ * The options must not ask for acknowledgement, as nothing would wait for it;
+ * use wamp_session::publish_acknowledged for that.
+ *
+ * \see wamp_session::prepare_topic
+ */
+class wamp_prepared_topic
+{
+public:
+    /*!
+     * \throw std::invalid_argument if @p options ask for acknowledgement.
+     */
+    wamp_prepared_topic(const std::string& topic,
+            const publish_options& options = publish_options());
+
+    //
+    // functions only called internally by wamp_session
+
+    /// The serialized PUBLISH.Options and PUBLISH.Topic.
+    const msgpack::sbuffer& encoded() const;
+
+private:
+    std::shared_ptr<msgpack::sbuffer> m_encoded;
+};
+
+} // namespace autobahn
+
+#include "wamp_prepared_topic.ipp"
+
+#endif // AUTOBAHN_WAMP_PREPARED_TOPIC_HPP
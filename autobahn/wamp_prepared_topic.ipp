@@ -0,0 +1,43 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+
+namespace autobahn {
+
+inline wamp_prepared_topic::wamp_prepared_topic(
+        const std::string& topic, const publish_options& options)
+    : m_encoded(std::make_shared<msgpack::sbuffer>(topic.size() + 32))
+{
+    auto acknowledge = options.find("acknowledge");
+    if (acknowledge != options.end() && !(acknowledge->second.type == msgpack::type::BOOLEAN
+            && !acknowledge->second.via.boolean)) {
+        throw std::invalid_argument("prepared topics cannot be published with acknowledgement");
+    }
+
+    msgpack::packer<msgpack::sbuffer> packer(*m_encoded);
+    packer.pack(options);
+    packer.pack(topic);
+}
+
+inline const msgpack::sbuffer& wamp_prepared_topic::encoded() const
+{
+    return *m_encoded;
+}
+
+} // namespace autobahn
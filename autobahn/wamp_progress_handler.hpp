@@ -0,0 +1,33 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_PROGRESS_HANDLER_HPP
+#define AUTOBAHN_WAMP_PROGRESS_HANDLER_HPP
+
+#include "wamp_call_result.hpp"
+
+#include <functional>
+
+namespace autobahn {
+
+/// Handler type for progressive call results, see wamp_call_options::set_progress_handler
+typedef std::function<void(const wamp_call_result&)> wamp_progress_handler;
+
+} // namespace autobahn
+
+#endif // AUTOBAHN_WAMP_PROGRESS_HANDLER_HPP
@@ -23,7 +23,7 @@
 
 namespace autobahn {
 
-/// Represents a topic subscription.
+/// Represents a publication acknowledged by the broker.
 class wamp_publication
 {
 public:
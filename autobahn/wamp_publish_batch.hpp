@@ -0,0 +1,93 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_PUBLISH_BATCH_HPP
+#define AUTOBAHN_WAMP_PUBLISH_BATCH_HPP
+
+#include "wamp_frames.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <msgpack.hpp>
+#include <string>
+
+namespace autobahn {
+
+/*!
+ * A batch of events, possibly to different topics, that a session sends with a
+ * single write.
+ *
+ * The PUBLISH messages are serialized as they are added; request IDs are
+ * filled in by wamp_session::publish_batch() when sending the batch.
+ */
+class wamp_publish_batch
+{
+public:
+    wamp_publish_batch();
+
+    /*!
+     * Add an event with empty payload.
+     *
+     * \param topic The URI of the topic to publish to.
+     */
+    void publish(const std::string& topic);
+
+    /*!
+     * Add an event with positional payload.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param arguments The positional payload for the event.
+     */
+    template <typename List>
+    void publish(const std::string& topic, const List& arguments);
+
+    /*!
+     * Add an event with both positional and keyword payload.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param arguments The positional payload for the event.
+     * \param kw_arguments The keyword payload for the event.
+     */
+    template <typename List, typename Map>
+    void publish(const std::string& topic, const List& arguments, const Map& kw_arguments);
+
+    /*!
+     * The number of events in the batch.
+     */
+    std::size_t size() const;
+
+    bool empty() const;
+
+    //
+    // functions only called internally by wamp_session
+
+    wamp_frames& frames();
+
+private:
+    /// Pack the header of a PUBLISH message up to and including the topic.
+    void pack_header(msgpack::packer<msgpack::sbuffer>& packer, uint32_t length, const std::string& topic);
+
+    wamp_frames m_frames;
+};
+
+} // namespace autobahn
+
+#include "wamp_publish_batch.ipp"
+
+#endif // AUTOBAHN_WAMP_PUBLISH_BATCH_HPP
@@ -0,0 +1,89 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "wamp_message_type.hpp"
+
+namespace autobahn {
+
+inline wamp_publish_batch::wamp_publish_batch()
+    : m_frames()
+{
+}
+
+inline void wamp_publish_batch::publish(const std::string& topic)
+{
+    msgpack::packer<msgpack::sbuffer> packer(m_frames.buffer());
+
+    // [PUBLISH, Request|id, Options|dict, Topic|uri]
+    m_frames.begin_frame();
+    pack_header(packer, 4, topic);
+    m_frames.end_frame();
+}
+
+template <typename List>
+inline void wamp_publish_batch::publish(const std::string& topic, const List& arguments)
+{
+    msgpack::packer<msgpack::sbuffer> packer(m_frames.buffer());
+
+    // [PUBLISH, Request|id, Options|dict, Topic|uri, Arguments|list]
+    m_frames.begin_frame();
+    pack_header(packer, 5, topic);
+    packer.pack(arguments);
+    m_frames.end_frame();
+}
+
+template <typename List, typename Map>
+inline void wamp_publish_batch::publish(
+        const std::string& topic, const List& arguments, const Map& kw_arguments)
+{
+    msgpack::packer<msgpack::sbuffer> packer(m_frames.buffer());
+
+    // [PUBLISH, Request|id, Options|dict, Topic|uri, Arguments|list, ArgumentsKw|dict]
+    m_frames.begin_frame();
+    pack_header(packer, 6, topic);
+    packer.pack(arguments);
+    packer.pack(kw_arguments);
+    m_frames.end_frame();
+}
+
+inline std::size_t wamp_publish_batch::size() const
+{
+    return m_frames.size();
+}
+
+inline bool wamp_publish_batch::empty() const
+{
+    return m_frames.empty();
+}
+
+inline wamp_frames& wamp_publish_batch::frames()
+{
+    return m_frames;
+}
+
+inline void wamp_publish_batch::pack_header(
+        msgpack::packer<msgpack::sbuffer>& packer, uint32_t length, const std::string& topic)
+{
+    packer.pack_array(length);
+    packer.pack(static_cast<int>(message_type::PUBLISH));
+    m_frames.pack_request_id(packer);
+    packer.pack_map(0);
+    packer.pack(topic);
+}
+
+} // namespace autobahn
@@ -0,0 +1,92 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_RAW_PAYLOAD_HPP
+#define AUTOBAHN_WAMP_RAW_PAYLOAD_HPP
+
+#include "wamp_msgpack_cursor.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <msgpack.hpp>
+
+namespace autobahn {
+
+namespace detail {
+
+/*!
+ * Check that @p span holds exactly one complete msgpack element of @p type.
+ *
+ * @throw std::invalid_argument naming the @p description of the span otherwise
+ */
+void check_raw_payload_element(const wamp_msgpack_span& span, msgpack::type::object_type type,
+        const char* description);
+
+/*!
+ * The number of payload elements a message carrying @p arguments and
+ * @p kw_arguments needs: none, the arguments, or the arguments followed by
+ * the keyword arguments. An empty span stands for an absent payload element.
+ *
+ * @throw std::invalid_argument if @p arguments is not exactly one complete
+ *        msgpack array or @p kw_arguments is not exactly one complete msgpack map
+ */
+std::size_t raw_payload_elements(const wamp_msgpack_span& arguments, const wamp_msgpack_span& kw_arguments);
+
+/*!
+ * Append the payload elements counted by raw_payload_elements() to @p buffer.
+ * Positional arguments are written as an empty array if only keyword arguments
+ * are given.
+ */
+void write_raw_payload(msgpack::sbuffer& buffer,
+        const wamp_msgpack_span& arguments, const wamp_msgpack_span& kw_arguments);
+
+} // namespace detail
+
+/*!
+ * The msgpack encoding of a decoded payload element, for the raw payload
+ * accessors of messages that were unpacked eagerly. The element is encoded
+ * with the first access and the encoding is shared by copies.
+ *
+ * Accesses may happen on several threads at once.
+ */
+class wamp_raw_encoding
+{
+public:
+    wamp_raw_encoding();
+    wamp_raw_encoding(const wamp_raw_encoding& other);
+    wamp_raw_encoding& operator=(const wamp_raw_encoding& other);
+
+    /*!
+     * The encoding of @p object, or an empty span if @p object is an empty
+     * array or map. @p object must be the same for all accesses until reset()
+     * is called.
+     */
+    wamp_msgpack_span span(const msgpack::object& object) const;
+
+    /// Forget the encoding, for when the object encoded changes.
+    void reset();
+
+private:
+    mutable std::shared_ptr<const msgpack::sbuffer> m_encoded;
+};
+
+} // namespace autobahn
+
+#include "wamp_raw_payload.ipp"
+
+#endif // AUTOBAHN_WAMP_RAW_PAYLOAD_HPP
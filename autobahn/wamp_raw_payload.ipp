@@ -0,0 +1,129 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <stdexcept>
+#include <string>
+
+namespace autobahn {
+
+namespace detail {
+
+inline void check_raw_payload_element(const wamp_msgpack_span& span, msgpack::type::object_type type,
+        const char* description)
+{
+    // The whole element is walked, not just its outermost header: the bytes are
+    // copied into the message as they are, so a truncated element or trailing
+    // bytes would corrupt the message and everything sent after it.
+    bool valid;
+    try {
+        valid = read_msgpack_header(span.data(), span.size(), 0).type == type
+                && skip_msgpack_element(span.data(), span.size(), 0) == span.size();
+    } catch (const protocol_error&) {
+        valid = false;
+    }
+
+    if (!valid) {
+        throw std::invalid_argument(std::string(description) + " are not a single, complete msgpack "
+                + (type == msgpack::type::ARRAY ? "array" : "map"));
+    }
+}
+
+inline std::size_t raw_payload_elements(
+        const wamp_msgpack_span& arguments, const wamp_msgpack_span& kw_arguments)
+{
+    if (!arguments.empty()) {
+        check_raw_payload_element(arguments, msgpack::type::ARRAY, "raw arguments");
+    }
+    if (!kw_arguments.empty()) {
+        check_raw_payload_element(kw_arguments, msgpack::type::MAP, "raw keyword arguments");
+    }
+
+    if (!kw_arguments.empty()) {
+        return 2;
+    }
+    return arguments.empty() ? 0 : 1;
+}
+
+inline void write_raw_payload(msgpack::sbuffer& buffer,
+        const wamp_msgpack_span& arguments, const wamp_msgpack_span& kw_arguments)
+{
+    if (!arguments.empty()) {
+        buffer.write(arguments.data(), arguments.size());
+    } else if (!kw_arguments.empty()) {
+        msgpack::packer<msgpack::sbuffer> packer(buffer);
+        packer.pack_array(0);
+    }
+
+    if (!kw_arguments.empty()) {
+        buffer.write(kw_arguments.data(), kw_arguments.size());
+    }
+}
+
+} // namespace detail
+
+inline wamp_raw_encoding::wamp_raw_encoding()
+    : m_encoded()
+{
+}
+
+inline wamp_raw_encoding::wamp_raw_encoding(const wamp_raw_encoding& other)
+    : m_encoded(std::atomic_load(&other.m_encoded))
+{
+}
+
+inline wamp_raw_encoding& wamp_raw_encoding::operator=(const wamp_raw_encoding& other)
+{
+    if (this != &other) {
+        std::atomic_store(&m_encoded, std::atomic_load(&other.m_encoded));
+    }
+    return *this;
+}
+
+inline wamp_msgpack_span wamp_raw_encoding::span(const msgpack::object& object) const
+{
+    if ((object.type == msgpack::type::ARRAY && object.via.array.size == 0)
+            || (object.type == msgpack::type::MAP && object.via.map.size == 0))
+    {
+        return wamp_msgpack_span();
+    }
+
+    auto encoded = std::atomic_load(&m_encoded);
+    if (!encoded) {
+        // Threads racing here each encode the object; one of the encodings is kept.
+        auto buffer = std::make_shared<msgpack::sbuffer>();
+        msgpack::packer<msgpack::sbuffer> packer(*buffer);
+        packer.pack(object);
+
+        std::shared_ptr<const msgpack::sbuffer> built = buffer;
+        std::shared_ptr<const msgpack::sbuffer> expected;
+        if (std::atomic_compare_exchange_strong(&m_encoded, &expected, built)) {
+            encoded = built;
+        } else {
+            encoded = expected;
+        }
+    }
+
+    return wamp_msgpack_span(encoded->data(), encoded->size());
+}
+
+inline void wamp_raw_encoding::reset()
+{
+    std::atomic_store(&m_encoded, std::shared_ptr<const msgpack::sbuffer>());
+}
+
+} // namespace autobahn
@@ -21,6 +21,7 @@
 
 #include "wamp_procedure.hpp"
 #include "wamp_registration.hpp"
+#include "wamp_typed_procedure.hpp"
 
 // http://stackoverflow.com/questions/22597948/using-boostfuture-with-then-continuations/
 #define BOOST_THREAD_PROVIDES_FUTURE
@@ -36,15 +37,18 @@ class wamp_register_request
 public:
     wamp_register_request();
     wamp_register_request(const wamp_procedure& procedure);
+    wamp_register_request(const wamp_typed_procedure& typed_procedure);
     wamp_register_request(wamp_register_request&& other);
 
     const wamp_procedure& procedure() const;
+    const wamp_typed_procedure& typed_procedure() const;
     boost::promise<wamp_registration>& response();
     void set_procedure(wamp_procedure procedure) const;
     void set_response(const wamp_registration& registration);
 
 private:
     wamp_procedure m_procedure;
+    wamp_typed_procedure m_typed_procedure;
     boost::promise<wamp_registration> m_response;
 };
 
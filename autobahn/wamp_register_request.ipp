@@ -20,18 +20,28 @@ namespace autobahn {
 
 inline wamp_register_request::wamp_register_request()
     : m_procedure()
+    , m_typed_procedure()
     , m_response()
 {
 }
 
 inline wamp_register_request::wamp_register_request(const wamp_procedure& procedure)
     : m_procedure(procedure)
+    , m_typed_procedure()
+    , m_response()
+{
+}
+
+inline wamp_register_request::wamp_register_request(const wamp_typed_procedure& typed_procedure)
+    : m_procedure()
+    , m_typed_procedure(typed_procedure)
     , m_response()
 {
 }
 
 inline wamp_register_request::wamp_register_request(wamp_register_request&& other)
     : m_procedure(std::move(other.m_procedure))
+    , m_typed_procedure(std::move(other.m_typed_procedure))
     , m_response(std::move(other.m_response))
 {
 }
@@ -41,6 +51,11 @@ inline const wamp_procedure& wamp_register_request::procedure() const
     return m_procedure;
 }
 
+inline const wamp_typed_procedure& wamp_register_request::typed_procedure() const
+{
+    return m_typed_procedure;
+}
+
 inline boost::promise<wamp_registration>& wamp_register_request::response()
 {
     return m_response;
@@ -0,0 +1,139 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_RUNTIME_HPP
+#define AUTOBAHN_WAMP_RUNTIME_HPP
+
+#include "wamp_session.hpp"
+#include "wamp_tcp_client.hpp"
+
+#include <atomic>
+#include <boost/asio.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A set of reactors (io_services), each run by its own io thread, over which
+ * wamp_tcp_client instances are distributed.
+ *
+ * Every client created by the runtime is bound to exactly one reactor for its
+ * whole lifetime. Work dispatched through wamp_tcp_client::dispatch() from that
+ * reactor's thread runs inline, so sessions on different reactors never contend
+ * on a shared io_service queue.
+ */
+class wamp_runtime
+{
+public:
+    /*!
+     * Create a runtime. The reactors are not run until start() is called.
+     *
+     * \param reactors The number of reactors to create. Zero selects one reactor
+     *        per hardware thread.
+     * \param pin_threads Whether to pin the io thread of reactor i to the i-th
+     *        CPU the process may run on (modulo their number). Ignored on
+     *        platforms without thread affinity support.
+     */
+    explicit wamp_runtime(std::size_t reactors = 0, bool pin_threads = true);
+
+    /*!
+     * Stops all reactors and joins their io threads.
+     */
+    ~wamp_runtime();
+
+    wamp_runtime(const wamp_runtime&) = delete;
+    wamp_runtime& operator=(const wamp_runtime&) = delete;
+
+    /*!
+     * Start one io thread per reactor.
+     */
+    void start();
+
+    /*!
+     * Stop all reactors and join their io threads. Outstanding handlers are
+     * abandoned.
+     */
+    void stop();
+
+    /*!
+     * The number of reactors owned by this runtime.
+     */
+    std::size_t size() const;
+
+    /*!
+     * The io_service of the reactor with the given @p index.
+     *
+     * @throw std::out_of_range
+     */
+    const std::shared_ptr<boost::asio::io_service>& reactor(std::size_t index) const;
+
+    /*!
+     * Create a client on the next reactor in round robin order.
+     *
+     * \param endpoint The rawsocket endpoint of the WAMP router.
+     * \param realm The realm to join once launched.
+     * \param debug Enable debug output of the underlying session.
+     * \return The client, bound to its reactor. Call launch() to connect.
+     */
+    std::shared_ptr<wamp_tcp_client> create_client(
+            const boost::asio::ip::tcp::endpoint& endpoint,
+            const std::string& realm,
+            bool debug = false);
+
+    /*!
+     * Create a client on the reactor with the given @p index.
+     *
+     * @throw std::out_of_range
+     */
+    std::shared_ptr<wamp_tcp_client> create_client(
+            std::size_t reactor,
+            const boost::asio::ip::tcp::endpoint& endpoint,
+            const std::string& realm,
+            bool debug = false);
+
+private:
+    /// The CPUs the calling thread may run on, empty if unknown.
+    static std::vector<int> allowed_cpus();
+
+    /// Pin the calling thread, the io thread of reactor @p index, to @p cpu.
+    static void pin_current_thread(std::size_t index, int cpu);
+
+    bool m_pin_threads;
+
+    /// Reactors, one io_service each.
+    std::vector<std::shared_ptr<boost::asio::io_service>> m_reactors;
+
+    /// Keeps each reactor running while it has no outstanding work.
+    std::vector<std::unique_ptr<boost::asio::io_service::work>> m_work;
+
+    /// One io thread per reactor, only populated while started.
+    std::vector<std::thread> m_threads;
+
+    /// Reactor index the next round robin client is created on.
+    std::atomic<std::size_t> m_next_reactor;
+};
+
+} // namespace autobahn
+
+#include "wamp_runtime.ipp"
+
+#endif // AUTOBAHN_WAMP_RUNTIME_HPP
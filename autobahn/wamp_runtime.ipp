@@ -0,0 +1,166 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+namespace autobahn {
+
+inline wamp_runtime::wamp_runtime(std::size_t reactors, bool pin_threads)
+    : m_pin_threads(pin_threads)
+    , m_reactors()
+    , m_work()
+    , m_threads()
+    , m_next_reactor(ATOMIC_VAR_INIT(0))
+{
+    if (reactors == 0) {
+        reactors = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_reactors.reserve(reactors);
+    for (std::size_t i = 0; i < reactors; ++i) {
+        // Each reactor is only ever run by a single thread.
+        m_reactors.push_back(std::make_shared<boost::asio::io_service>(1));
+    }
+}
+
+inline wamp_runtime::~wamp_runtime()
+{
+    stop();
+}
+
+inline void wamp_runtime::start()
+{
+    if (!m_threads.empty()) {
+        throw std::logic_error("runtime already started");
+    }
+
+    std::vector<int> cpus;
+    if (m_pin_threads) {
+        cpus = allowed_cpus();
+    }
+
+    m_threads.reserve(m_reactors.size());
+    for (std::size_t i = 0; i < m_reactors.size(); ++i) {
+        auto io = m_reactors[i];
+        int cpu = cpus.empty() ? -1 : cpus[i % cpus.size()];
+        m_work.emplace_back(new boost::asio::io_service::work(*io));
+        m_threads.emplace_back([io, i, cpu]() {
+            // Pin before running anything, so that no handler runs on another CPU first.
+            if (cpu >= 0) {
+                pin_current_thread(i, cpu);
+            }
+            io->run();
+        });
+    }
+}
+
+inline void wamp_runtime::stop()
+{
+    m_work.clear();
+
+    for (auto& io : m_reactors) {
+        io->stop();
+    }
+
+    for (auto& thread : m_threads) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    m_threads.clear();
+
+    for (auto& io : m_reactors) {
+        io->reset();
+    }
+}
+
+inline std::size_t wamp_runtime::size() const
+{
+    return m_reactors.size();
+}
+
+inline const std::shared_ptr<boost::asio::io_service>& wamp_runtime::reactor(std::size_t index) const
+{
+    return m_reactors.at(index);
+}
+
+inline std::shared_ptr<wamp_tcp_client> wamp_runtime::create_client(
+        const boost::asio::ip::tcp::endpoint& endpoint,
+        const std::string& realm,
+        bool debug)
+{
+    std::size_t index = m_next_reactor++ % m_reactors.size();
+    return create_client(index, endpoint, realm, debug);
+}
+
+inline std::shared_ptr<wamp_tcp_client> wamp_runtime::create_client(
+        std::size_t reactor,
+        const boost::asio::ip::tcp::endpoint& endpoint,
+        const std::string& realm,
+        bool debug)
+{
+    return std::make_shared<wamp_tcp_client>(m_reactors.at(reactor), endpoint, realm, debug);
+}
+
+inline std::vector<int> wamp_runtime::allowed_cpus()
+{
+    std::vector<int> cpus;
+#if defined(__linux__)
+    // Inside a restricted cpuset or under taskset, only some of the CPUs are
+    // available, and not necessarily the first ones.
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+            if (CPU_ISSET(cpu, &cpu_set)) {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+#endif
+    return cpus;
+}
+
+inline void wamp_runtime::pin_current_thread(std::size_t index, int cpu)
+{
+#if defined(__linux__)
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(cpu, &cpu_set);
+
+    // Pinning is best effort; the reactor runs unpinned if it fails.
+    int error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+    if (error != 0) {
+        std::cerr << "Warning: could not pin the thread of reactor " << index
+                  << " to CPU " << cpu << ": " << std::strerror(error) << std::endl;
+    }
+#else
+    (void) index;
+    (void) cpu;
+#endif
+}
+
+} // namespace autobahn
@@ -19,10 +19,26 @@
 #ifndef AUTOBAHN_SESSION_HPP
 #define AUTOBAHN_SESSION_HPP
 
+#include "wamp_argument_pack.hpp"
+#include "wamp_call_batch.hpp"
+#include "wamp_call_options.hpp"
 #include "wamp_call_result.hpp"
 #include "wamp_event_handler.hpp"
+#include "wamp_invocation_options.hpp"
+#include "wamp_lazy_payload.hpp"
 #include "wamp_message.hpp"
+#include "wamp_message_validator.hpp"
+#include "wamp_prepared_call.hpp"
+#include "wamp_prepared_topic.hpp"
 #include "wamp_procedure.hpp"
+#include "wamp_publication.hpp"
+#include "wamp_publish_batch.hpp"
+#include "wamp_raw_payload.hpp"
+#include "wamp_subscribe_options.hpp"
+#include "wamp_timing_wheel.hpp"
+#include "wamp_typed_event_handler.hpp"
+#include "wamp_typed_procedure.hpp"
+#include "wamp_zone_pool.hpp"
 
 // http://stackoverflow.com/questions/22597948/using-boostfuture-with-then-continuations/
 #define BOOST_THREAD_PROVIDES_FUTURE
@@ -31,6 +47,8 @@
 #include <boost/asio.hpp>
 #include <boost/thread/future.hpp>
 #include <boost/signals2.hpp>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
 #include <functional>
 #include <istream>
@@ -68,6 +86,9 @@ class wamp_session : public std::enable_shared_from_this<wamp_session<IStream, O
 {
 public:
 
+    /// Capacity of the receive buffer kept between messages unless set otherwise.
+    static const std::size_t DEFAULT_RECEIVE_BUFFER_LIMIT = 64 * 1024;
+
     /*!
      * Create a new WAMP session.
      *
@@ -87,7 +108,8 @@ public:
 
     /*!
      * Closes the IStream and the OStream provided to the constructor
-     * of this session.
+     * of this session. Calls still outstanding fail with an
+     * autobahn::no_session_error.
      */
     boost::future<void> stop();
 
@@ -133,6 +155,117 @@ public:
     template <typename List, typename Map>
     void publish(const std::string& topic, const List& arguments, const Map& kw_arguments);
 
+    /*!
+     * Publish an event with an already encoded payload to a topic, e.g. the
+     * raw_arguments() and raw_kw_arguments() of an event to forward. The bytes
+     * are checked to hold one complete element each and copied into the message
+     * as they are, without decoding them.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param arguments The msgpack encoded positional payload, or an empty span for none.
+     * \param kw_arguments The msgpack encoded keyword payload, or an empty span for none.
+     * \throw std::invalid_argument if @p arguments is not exactly one complete
+     *        msgpack array or @p kw_arguments is not exactly one complete msgpack map
+     */
+    void publish_raw(const std::string& topic, const wamp_msgpack_span& arguments,
+            const wamp_msgpack_span& kw_arguments = wamp_msgpack_span());
+
+    /*!
+     * Publish an event with empty payload to a topic and have the broker
+     * acknowledge it.
+     *
+     * Acknowledgements are matched by request ID, so any number of publications
+     * can be awaiting theirs at the same time. Those still waiting when the
+     * session is stopped or loses its connection fail with no_session_error.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \return A future that resolves to the autobahn::wamp_publication once the
+     *         broker accepted the event, or fails if the broker rejected it.
+     */
+    boost::future<wamp_publication> publish_acknowledged(const std::string& topic);
+
+    /*!
+     * Publish an event with positional payload to a topic and have the broker
+     * acknowledge it.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param arguments The positional payload for the event.
+     * \return A future that resolves to the autobahn::wamp_publication once the
+     *         broker accepted the event, or fails if the broker rejected it.
+     */
+    template <typename List>
+    boost::future<wamp_publication> publish_acknowledged(
+            const std::string& topic, const List& arguments);
+
+    /*!
+     * Publish an event with both positional and keyword payload to a topic and
+     * have the broker acknowledge it.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param arguments The positional payload for the event.
+     * \param kw_arguments The keyword payload for the event.
+     * \return A future that resolves to the autobahn::wamp_publication once the
+     *         broker accepted the event, or fails if the broker rejected it.
+     */
+    template <typename List, typename Map>
+    boost::future<wamp_publication> publish_acknowledged(
+            const std::string& topic, const List& arguments, const Map& kw_arguments);
+
+    /*!
+     * Prepare a topic to publish to repeatedly. Its options and URI are
+     * serialized once, instead of with every event.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param options Options sent with every event.
+     * \return A handle to pass to publish() instead of the topic URI.
+     * \throw std::invalid_argument if @p options ask for acknowledgement.
+     */
+    wamp_prepared_topic prepare_topic(
+            const std::string& topic, const publish_options& options = publish_options()) const;
+
+    /*!
+     * Publish an event with empty payload to a prepared topic.
+     *
+     * \param topic The topic to publish to, see prepare_topic().
+     */
+    void publish(const wamp_prepared_topic& topic);
+
+    /*!
+     * Publish an event with positional payload to a prepared topic.
+     *
+     * \param topic The topic to publish to, see prepare_topic().
+     * \param arguments The positional payload for the event.
+     */
+    template <typename List>
+    void publish(const wamp_prepared_topic& topic, const List& arguments);
+
+    /*!
+     * Publish an event with both positional and keyword payload to a prepared topic.
+     *
+     * \param topic The topic to publish to, see prepare_topic().
+     * \param arguments The positional payload for the event.
+     * \param kw_arguments The keyword payload for the event.
+     */
+    template <typename List, typename Map>
+    void publish(const wamp_prepared_topic& topic, const List& arguments, const Map& kw_arguments);
+
+    /*!
+     * Publish a batch of events with a single write to the transport.
+     *
+     * \param batch The events to publish, moved into the session.
+     */
+    void publish_batch(wamp_publish_batch batch);
+
+    /*!
+     * Publish one event per element of @p payloads to a topic, with a single
+     * write to the transport.
+     *
+     * \param topic The URI of the topic to publish to.
+     * \param payloads A range of positional payloads, one per event.
+     */
+    template <typename Range>
+    void publish_batch(const std::string& topic, const Range& payloads);
+
     /*!
      * Subscribe a handler to a topic to receive events.
      *
@@ -143,6 +276,39 @@ public:
     boost::future<wamp_subscription> subscribe(
             const std::string& topic, const wamp_event_handler& handler);
 
+    /*!
+     * Subscribe a handler to a topic, delivering events as described by @p options.
+     *
+     * With an executor set in @p options, events are queued per subscription and
+     * the handler runs on the executor, one event at a time and in order, so a
+     * slow handler does not hold up the session's io thread.
+     *
+     * \param topic The URI of the topic to subscribe to.
+     * \param handler The handler that will receive events under the subscription.
+     * \param options How events are delivered to the handler.
+     * \return A future that resolves to a autobahn::subscription
+     */
+    boost::future<wamp_subscription> subscribe(
+            const std::string& topic,
+            const wamp_event_handler& handler,
+            const wamp_subscribe_options& options);
+
+    /*!
+     * Subscribe a handler with a typed signature to a topic, e.g.
+     * `session->subscribe<std::string, double>("com.example.tick", on_tick);`
+     *
+     * The positional payload of each event is validated and converted straight
+     * into the handler's parameters, without creating a wamp_event. Keyword
+     * payload is ignored. Events whose payload does not match the signature are
+     * dropped.
+     *
+     * \param topic The URI of the topic to subscribe to.
+     * \param handler The handler, callable with parameters of the types @p Arg, @p Args.
+     * \return A future that resolves to a autobahn::subscription
+     */
+    template <typename Arg, typename... Args, typename Function>
+    boost::future<wamp_subscription> subscribe(const std::string& topic, Function handler);
+
     /*!
      * Unubscribe a handler to previosuly subscribed topic.
      *
@@ -159,6 +325,17 @@ public:
      */
     boost::future<wamp_call_result> call(const std::string& procedure);
 
+    /*!
+     * Calls a remote procedure with no arguments.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param options Options for the call.
+     * \return A future that resolves to the result of the remote procedure call.
+     *         It fails with an autobahn::timeout_error if the call times out.
+     */
+    boost::future<wamp_call_result> call(
+            const std::string& procedure, const wamp_call_options& options);
+
     /*!
      * Calls a remote procedure with positional arguments.
      *
@@ -170,6 +347,19 @@ public:
     boost::future<wamp_call_result> call(
             const std::string& procedure, const List& arguments);
 
+    /*!
+     * Calls a remote procedure with positional arguments.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param arguments The positional arguments for the call.
+     * \param options Options for the call.
+     * \return A future that resolves to the result of the remote procedure call.
+     *         It fails with an autobahn::timeout_error if the call times out.
+     */
+    template <typename List>
+    boost::future<wamp_call_result> call(
+            const std::string& procedure, const List& arguments, const wamp_call_options& options);
+
     /*!
      * Calls a remote procedure with positional and keyword arguments.
      *
@@ -182,6 +372,41 @@ public:
     boost::future<wamp_call_result> call(
             const std::string& procedure, const List& arguments, const Map& kw_arguments);
 
+    /*!
+     * Calls a remote procedure with positional and keyword arguments.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param arguments The positional arguments for the call.
+     * \param kw_arguments The keyword arguments for the call.
+     * \param options Options for the call.
+     * \return A future that resolves to the result of the remote procedure call.
+     *         It fails with an autobahn::timeout_error if the call times out.
+     */
+    template<typename List, typename Map>
+    boost::future<wamp_call_result> call(
+            const std::string& procedure, const List& arguments, const Map& kw_arguments,
+            const wamp_call_options& options);
+
+    /*!
+     * Calls a remote procedure with already encoded arguments, e.g. the
+     * raw_arguments() and raw_kw_arguments() of an invocation to forward. The
+     * bytes are checked to hold one complete element each and copied into the
+     * message as they are, without decoding them.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param arguments The msgpack encoded positional arguments, or an empty span for none.
+     * \param kw_arguments The msgpack encoded keyword arguments, or an empty span for none.
+     * \param options Options for the call.
+     * \return A future that resolves to the result of the remote procedure call.
+     *         It fails with an autobahn::timeout_error if the call times out.
+     * \throw std::invalid_argument if @p arguments is not exactly one complete
+     *        msgpack array or @p kw_arguments is not exactly one complete msgpack map
+     */
+    boost::future<wamp_call_result> call_raw(
+            const std::string& procedure, const wamp_msgpack_span& arguments,
+            const wamp_msgpack_span& kw_arguments = wamp_msgpack_span(),
+            const wamp_call_options& options = wamp_call_options());
+
     /*!
      * Register an procedure as a procedure that can be called remotely.
      *
@@ -195,6 +420,159 @@ public:
             const wamp_procedure& procedure,
             const provide_options& options = provide_options());
 
+    /*!
+     * Register a procedure with a typed signature, e.g.
+     * `session->provide<int(int, int)>("com.example.add", add);`
+     *
+     * Invocations are handled on the session's io thread without creating a
+     * wamp_invocation: the positional arguments are decoded straight into the
+     * parameters of @p Signature and the return value is packed straight into
+     * the YIELD. Invocations whose arguments do not match the signature are
+     * answered with "wamp.error.invalid_argument".
+     *
+     * \param uri The URI under which the procedure is to be exposed.
+     * \param procedure The procedure, callable with the parameters of @p Signature.
+     * \param options Options when registering a procedure.
+     * \return A future that resolves to a autobahn::registration
+     */
+    template <typename Signature, typename Function>
+    boost::future<wamp_registration> provide(
+            const std::string& uri,
+            Function procedure,
+            const provide_options& options = provide_options());
+
+    /*!
+     * Register a procedure whose invocations are executed as described by
+     * @p invocation_options, e.g. on an executor with a cap on concurrent executions.
+     *
+     * \param uri The URI under which the procedure is to be exposed.
+     * \param procedure The procedure to be exposed as a remotely callable procedure.
+     * \param options Options when registering a procedure.
+     * \param invocation_options How invocations of the procedure are executed.
+     * \return A future that resolves to a autobahn::registration
+     */
+    boost::future<wamp_registration> provide(
+            const std::string& uri,
+            const wamp_procedure& procedure,
+            const provide_options& options,
+            const wamp_invocation_options& invocation_options);
+
+    /*!
+     * Prepare a remote procedure to call repeatedly. Its options, including the
+     * session's default call timeout, and URI are serialized once, instead of
+     * with every call.
+     *
+     * \param procedure The URI of the remote procedure to call.
+     * \param options Options for every call.
+     * \return A handle to pass to call() instead of the procedure URI.
+     */
+    wamp_prepared_call prepare_call(
+            const std::string& procedure, const wamp_call_options& options = wamp_call_options()) const;
+
+    /*!
+     * Calls a prepared remote procedure with no arguments.
+     *
+     * \param procedure The procedure to call, see prepare_call().
+     * \return A future that resolves to the result of the remote procedure call.
+     */
+    boost::future<wamp_call_result> call(const wamp_prepared_call& procedure);
+
+    /*!
+     * Calls a prepared remote procedure with positional arguments.
+     *
+     * \param procedure The procedure to call, see prepare_call().
+     * \param arguments The positional arguments for the call.
+     * \return A future that resolves to the result of the remote procedure call.
+     */
+    template <typename List>
+    boost::future<wamp_call_result> call(const wamp_prepared_call& procedure, const List& arguments);
+
+    /*!
+     * Calls a prepared remote procedure with positional and keyword arguments.
+     *
+     * \param procedure The procedure to call, see prepare_call().
+     * \param arguments The positional arguments for the call.
+     * \param kw_arguments The keyword arguments for the call.
+     * \return A future that resolves to the result of the remote procedure call.
+     */
+    template <typename List, typename Map>
+    boost::future<wamp_call_result> call(
+            const wamp_prepared_call& procedure, const List& arguments, const Map& kw_arguments);
+
+    /*!
+     * Issue a batch of calls with a single write to the transport.
+     *
+     * \param batch The calls to issue, moved into the session.
+     * \return A future that resolves once all calls completed, to their
+     *         results in the order the calls were added to the batch. Each of
+     *         them holds the result or the error of its call. An empty batch
+     *         resolves right away, without writing anything.
+     */
+    boost::future<wamp_call_batch_results> call_many(wamp_call_batch batch);
+
+    /*!
+     * Keep the arguments of received events, call results and invocations msgpack
+     * encoded and decode them on access. Looking up a single positional or keyword
+     * argument then only decodes that argument, skipping over the bytes of the
+     * others, which pays off for handlers that read few of many arguments. Accessing
+     * all arguments at once decodes them once per message.
+     *
+     * Set this before starting the session; it is not synchronized with it.
+     */
+    void set_lazy_payloads(bool lazy);
+
+    /*!
+     * Set the capacity the receive buffer may keep after a message was processed.
+     * A buffer that grew beyond it for a large message is released and allocated
+     * again for the next message. Defaults to DEFAULT_RECEIVE_BUFFER_LIMIT.
+     */
+    void set_receive_buffer_limit(std::size_t max_capacity);
+
+    /*!
+     * Trade allocations per message for a small idle footprint, for processes
+     * holding many mostly idle sessions. In lean mode the session
+     *
+     * - releases its receive buffer after each message,
+     * - keeps no idle zones for unpacking messages and
+     * - frees its call timeout wheel whenever no call with a timeout is outstanding.
+     *
+     * Set this before starting the session; it is not synchronized with it.
+     */
+    void set_lean_mode(bool lean);
+
+    /*!
+     * The approximate number of octets this session occupies: the session object
+     * plus its receive buffer, idle zones, call timeout wheel and the entries of its
+     * request and handler tables. Heap state shared with futures handed out and
+     * memory held by user handlers are not included.
+     *
+     * Not synchronized with the session; call it on the io_service thread of the
+     * session or while the session is idle.
+     */
+    std::size_t memory_footprint() const;
+
+    /*!
+     * Set the limit of octets the session keeps in idle msgpack zones for unpacking
+     * received messages into. Zero disables pooling, so each message gets a freshly
+     * allocated zone.
+     */
+    void set_zone_pool_limit(std::size_t max_retained_bytes);
+
+    /*!
+     * Set the timeout of calls that do not set one in their options. A call that
+     * times out is canceled at the dealer and its future fails with an
+     * autobahn::timeout_error. Zero (the default) disables the timeout.
+     *
+     * Set this before issuing calls; it is not synchronized with them.
+     */
+    void set_default_call_timeout(const std::chrono::milliseconds& timeout);
+
+    /*!
+     * The number of calls issued on this session that have not yet received
+     * their RESULT or ERROR.
+     */
+    std::size_t outstanding_calls() const;
+
     boost::signals2::signal<void (const boost::system::error_code &)> m_onRxError;
 private:
     /// Handle error codes from the istream (filters out operation_aborted error), passes all others to m_onRxError signal
@@ -209,7 +587,11 @@ private:
     /// Process a WAMP RESULT message.
     void process_call_result(
             const wamp_message& message,
-            msgpack::unique_ptr<msgpack::zone>&& zone);
+            const std::shared_ptr<msgpack::zone>& zone,
+            const std::shared_ptr<wamp_lazy_payload>& payload);
+
+    /// Process a WAMP PUBLISHED message.
+    void process_published(const wamp_message& message);
 
     /// Process a WAMP SUBSCRIBED message.
     void process_subscribed(const wamp_message& message);
@@ -218,7 +600,10 @@ private:
     void process_unsubscribed(const wamp_message& message);
 
     /// Process a WAMP EVENT message.
-    void process_event(const wamp_message& message);
+    void process_event(
+            const wamp_message& message,
+            const std::shared_ptr<msgpack::zone>& zone,
+            const std::shared_ptr<wamp_lazy_payload>& payload);
 
     /// Process a WAMP REGISTERED message.
     void process_registered(const wamp_message& message);
@@ -226,15 +611,74 @@ private:
     /// Process a WAMP INVOCATION message.
     void process_invocation(
             const wamp_message& message,
-            msgpack::unique_ptr<msgpack::zone>&& zone);
+            const std::shared_ptr<msgpack::zone>& zone,
+            const std::shared_ptr<wamp_lazy_payload>& payload);
 
     /// Process a WAMP GOODBYE message.
     void process_goodbye(const wamp_message& message);
 
+    /// Send a packed PUBLISH message that is not acknowledged.
+    void dispatch_publish(const std::shared_ptr<msgpack::sbuffer>& buffer);
+
+    /// Register a packed SUBSCRIBE message as outstanding and send it.
+    boost::future<wamp_subscription> issue_subscribe(
+            uint64_t request_id,
+            const std::shared_ptr<msgpack::sbuffer>& buffer,
+            const std::shared_ptr<wamp_subscribe_request>& subscribe_request);
+
+    /// Register a packed REGISTER message as outstanding and send it.
+    boost::future<wamp_registration> issue_register(
+            uint64_t request_id,
+            const std::shared_ptr<msgpack::sbuffer>& buffer,
+            const std::shared_ptr<wamp_register_request>& register_request);
+
+    /// Register a packed PUBLISH message as awaiting acknowledgement and send it.
+    boost::future<wamp_publication> issue_publish(
+            uint64_t request_id, const std::shared_ptr<msgpack::sbuffer>& buffer);
+
+    /// The options of a call with the session defaults filled in.
+    wamp_call_options effective_call_options(const wamp_call_options& options) const;
+
+    /// Register a packed CALL message as outstanding and send it.
+    boost::future<wamp_call_result> issue_call(
+            uint64_t request_id,
+            const std::shared_ptr<msgpack::sbuffer>& buffer,
+            const wamp_call_options& options);
+
+    /// The current tick of the call timeout wheel.
+    uint64_t call_timeout_tick() const;
+
+    /// Schedule the timeout of an outstanding call and return the tick it expires at.
+    uint64_t schedule_call_timeout(uint64_t request_id, const std::chrono::milliseconds& timeout);
+
+    /// Remove the timeout of a call that completed before it, and stop the timer
+    /// when no call with a timeout is left.
+    void cancel_call_timeout(uint64_t request_id, const wamp_call& call);
+
+    /// Wait for the next tick of the call timeout wheel.
+    void arm_call_timer();
+
+    /// Remove an entry from the call timeout wheel, and stop the timer when the
+    /// wheel is left empty.
+    void cancel_timeout(uint64_t entry, uint64_t tick);
+
+    /// Fail and cancel an outstanding call that timed out.
+    void expire_call(uint64_t request_id);
+
+    /// Stop waiting for the answer to a canceled call; false if it was not waited for.
+    bool forget_canceled_call(uint64_t request_id);
+
+    /// Fail all outstanding calls and unacknowledged publications with
+    /// no_session_error, for when the connection is lost.
+    void fail_outstanding_calls();
+
     /// Send out message serialized in serialization buffer to ostream.
     void send(const std::shared_ptr<msgpack::sbuffer>& buffer);
 
-    /// Receive one message from istream in m_unpacker.
+    /// Send out messages serialized with their length prefixes to ostream.
+    void send_frames(const std::shared_ptr<msgpack::sbuffer>& frames);
+
+    /// Receive one message from istream into m_message_buffer.
     void receive_message();
 
     void got_handshake_reply(const boost::system::error_code& error);
@@ -243,7 +687,21 @@ private:
 
     void got_message_body(const boost::system::error_code& error);
 
-    void got_message(const msgpack::object& object, msgpack::unique_ptr<msgpack::zone>&& zone);
+    /*!
+     * Unpack the validated message from @p offset to @p end of the receive buffer into
+     * @p zone, keeping the arguments of EVENT, RESULT and INVOCATION messages encoded
+     * in @p payload. The message returned then ends before its arguments.
+     */
+    msgpack::object unpack_envelope(
+            const std::shared_ptr<msgpack::zone>& zone,
+            std::size_t& offset,
+            std::size_t end,
+            std::shared_ptr<wamp_lazy_payload>& payload);
+
+    void got_message(
+            const msgpack::object& object,
+            const std::shared_ptr<msgpack::zone>& zone,
+            const std::shared_ptr<wamp_lazy_payload>& payload);
 
 
     bool m_debug;
@@ -259,8 +717,20 @@ private:
     unsigned char m_buffer_message_length[4];
     uint32_t m_message_length;
 
-    /// MsgPack unserialization unpacker.
-    msgpack::unpacker m_unpacker;
+    /// Buffer the body of the message being received is read into.
+    std::vector<char> m_message_buffer;
+
+    /// Capacity the receive buffer may keep between messages.
+    std::size_t m_receive_buffer_limit;
+
+    /// Set to true in lean mode, see set_lean_mode().
+    bool m_lean;
+
+    /// Set to true to keep the arguments of received messages encoded, see set_lazy_payloads().
+    bool m_lazy_payloads;
+
+    /// Zones received messages are unpacked into.
+    wamp_zone_pool m_zone_pool;
 
     /// Last request ID of outgoing WAMP requests.
     std::atomic<uint64_t> m_request_id;
@@ -290,6 +760,46 @@ private:
     /// Map of outstanding WAMP calls (request ID -> call).
     std::map<uint64_t, std::shared_ptr<wamp_call>> m_calls;
 
+    /// Number of calls issued but not yet answered, readable from any thread.
+    std::atomic<std::size_t> m_outstanding_calls;
+
+    /// Timed out calls whose RESULT or ERROR is still to come (request ID -> tick
+    /// at which they are forgotten anyway, in case the dealer never answers).
+    std::map<uint64_t, uint64_t> m_canceled_calls;
+
+    /// How long to wait for the dealer to answer the CANCEL of a timed out call.
+    const std::chrono::milliseconds m_canceled_call_retention;
+
+    /// Marks the entries of canceled calls on the call timeout wheel; WAMP IDs
+    /// never use the top bit.
+    static const uint64_t CANCELED_CALL_TAG = uint64_t(1) << 63;
+
+    /// Timeout for calls that do not set one, zero for none.
+    std::chrono::milliseconds m_default_call_timeout;
+
+    /// Deadlines of outstanding calls by request ID, and of the wait for the answers
+    /// to canceled calls. Created with the first call that has a timeout.
+    std::unique_ptr<wamp_timing_wheel> m_call_timeouts;
+
+    /// Duration of one tick of the call timeout wheel.
+    const std::chrono::milliseconds m_call_timeout_resolution;
+
+    /// The time of tick zero of the call timeout wheel.
+    const std::chrono::steady_clock::time_point m_call_timeout_epoch;
+
+    /// Timer advancing the call timeout wheel while it has entries. Whoever cancels
+    /// it clears m_call_timer_armed.
+    boost::asio::steady_timer m_call_timer;
+
+    bool m_call_timer_armed;
+
+
+    //////////////////////////////////////////////////////////////////////////////////////
+    /// Publisher
+
+    /// Map of publications awaiting acknowledgement (request ID -> publication).
+    std::map<uint64_t, std::shared_ptr<boost::promise<wamp_publication>>> m_publish_requests;
+
 
     //////////////////////////////////////////////////////////////////////////////////////
     /// Subscriber
@@ -303,6 +813,9 @@ private:
     /// Map of subscribed handlers (subscription ID -> handler)
     std::multimap<uint64_t, wamp_event_handler> m_subscription_handlers;
 
+    /// Map of subscribed handlers with a typed signature (subscription ID -> handler)
+    std::multimap<uint64_t, wamp_typed_event_handler> m_typed_subscription_handlers;
+
 
     //////////////////////////////////////////////////////////////////////////////////////
     /// Callee
@@ -313,6 +826,9 @@ private:
     /// Map of registered procedures (registration ID -> procedure)
     std::map<uint64_t, wamp_procedure> m_procedures;
 
+    /// Map of procedures registered with a typed signature (registration ID -> procedure)
+    std::map<uint64_t, wamp_typed_procedure> m_typed_procedures;
+
     /// An unserialized, raw WAMP message.
     wamp_message m_message;
 };
@@ -18,11 +18,18 @@
 
 #include "exceptions.hpp"
 #include "wamp_call.hpp"
+#include "wamp_call_batch.hpp"
+#include "wamp_call_options.hpp"
 #include "wamp_call_result.hpp"
 #include "wamp_event.hpp"
+#include "wamp_event_queue.hpp"
 #include "wamp_invocation.hpp"
+#include "wamp_invocation_queue.hpp"
 #include "wamp_message_type.hpp"
+#include "wamp_prepared_call.hpp"
+#include "wamp_prepared_topic.hpp"
 #include "wamp_publication.hpp"
+#include "wamp_publish_batch.hpp"
 #include "wamp_registration.hpp"
 #include "wamp_register_request.hpp"
 #include "wamp_subscribe_request.hpp"
@@ -42,16 +49,42 @@
 
 namespace autobahn {
 
+namespace detail {
+
+/// The approximate heap footprint of the nodes of an ordered associative container.
+template <typename Table>
+inline std::size_t table_footprint(const Table& table)
+{
+    // a red-black tree node holds three links and a color next to its value
+    return table.size() * (sizeof(typename Table::value_type) + 4 * sizeof(void*));
+}
+
+} // namespace detail
+
 template<typename IStream, typename OStream>
 wamp_session<IStream, OStream>::wamp_session(boost::asio::io_service& io, IStream& in, OStream& out, bool debug)
     : m_debug(debug)
     , m_io(io)
     , m_in(in)
     , m_out(out)
+    , m_message_buffer()
+    , m_receive_buffer_limit(DEFAULT_RECEIVE_BUFFER_LIMIT)
+    , m_lean(false)
+    , m_lazy_payloads(false)
+    , m_zone_pool()
     , m_request_id(ATOMIC_VAR_INIT(0))
     , m_session_id(0)
     , m_goodbye_sent(false)
     , m_stopped(false)
+    , m_outstanding_calls(ATOMIC_VAR_INIT(0))
+    , m_canceled_calls()
+    , m_canceled_call_retention(60000)
+    , m_default_call_timeout(0)
+    , m_call_timeouts()
+    , m_call_timeout_resolution(10)
+    , m_call_timeout_epoch(std::chrono::steady_clock::now())
+    , m_call_timer(io)
+    , m_call_timer_armed(false)
 {
 }
 
@@ -137,6 +170,9 @@ boost::future<void> wamp_session<IStream, OStream>::stop()
         }
 
         m_stopped = true;
+        m_call_timer.cancel();
+        m_call_timer_armed = false;
+        fail_outstanding_calls();
 
         try {
             m_in.close();
@@ -171,9 +207,23 @@ boost::future<uint64_t> wamp_session<IStream, OStream>::join(const std::string&
 
     packer.pack_map(4);
     packer.pack(std::string("caller"));
-    packer.pack_map(0);
+    packer.pack_map(1);
+    packer.pack(std::string("features"));
+    packer.pack_map(3);
+    packer.pack(std::string("call_canceling"));
+    packer.pack(true);
+    packer.pack(std::string("call_timeout"));
+    packer.pack(true);
+    packer.pack(std::string("progressive_call_results"));
+    packer.pack(true);
     packer.pack(std::string("callee"));
-    packer.pack_map(0);
+    packer.pack_map(1);
+    packer.pack(std::string("features"));
+    packer.pack_map(2);
+    packer.pack(std::string("call_timeout"));
+    packer.pack(true);
+    packer.pack(std::string("progressive_call_results"));
+    packer.pack(true);
     packer.pack(std::string("publisher"));
     packer.pack_map(0);
     packer.pack(std::string("subscriber"));
@@ -249,8 +299,36 @@ boost::future<wamp_subscription> wamp_session<IStream, OStream>::subscribe(
     packer.pack_map(0);
     packer.pack(topic);
 
+    return issue_subscribe(request_id, buffer, std::make_shared<wamp_subscribe_request>(handler));
+}
+
+template<typename IStream, typename OStream>
+template <typename Arg, typename... Args, typename Function>
+boost::future<wamp_subscription> wamp_session<IStream, OStream>::subscribe(
+        const std::string& topic, Function handler)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+
+    // [SUBSCRIBE, Request|id, Options|dict, Topic|uri]
+    packer.pack_array(4);
+    packer.pack(static_cast<int>(message_type::SUBSCRIBE));
+    packer.pack(request_id);
+    packer.pack_map(0);
+    packer.pack(topic);
+
+    wamp_typed_event_handler typed_handler = make_typed_event_handler<Arg, Args...>(std::move(handler));
+    return issue_subscribe(request_id, buffer, std::make_shared<wamp_subscribe_request>(typed_handler));
+}
+
+template<typename IStream, typename OStream>
+boost::future<wamp_subscription> wamp_session<IStream, OStream>::issue_subscribe(
+        uint64_t request_id,
+        const std::shared_ptr<msgpack::sbuffer>& buffer,
+        const std::shared_ptr<wamp_subscribe_request>& subscribe_request)
+{
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-    auto subscribe_request = std::make_shared<wamp_subscribe_request>(handler);
 
     m_io.dispatch([=]() {
         auto shared_self = weak_self.lock();
@@ -270,6 +348,24 @@ boost::future<wamp_subscription> wamp_session<IStream, OStream>::subscribe(
     return subscribe_request->response().get_future();
 }
 
+template<typename IStream, typename OStream>
+boost::future<wamp_subscription> wamp_session<IStream, OStream>::subscribe(
+        const std::string& topic,
+        const wamp_event_handler& handler,
+        const wamp_subscribe_options& options)
+{
+    if (!options.executor()) {
+        return subscribe(topic, handler);
+    }
+
+    auto queue = std::make_shared<wamp_event_queue>(handler, options);
+    auto queued_handler = [queue](const wamp_event& event) {
+        queue->push(event);
+    };
+
+    return subscribe(topic, queued_handler);
+}
+
 template<typename IStream, typename OStream>
 boost::future<void> wamp_session<IStream, OStream>::unsubscribe(const wamp_subscription& subscription)
 {
@@ -319,8 +415,36 @@ boost::future<wamp_registration> wamp_session<IStream, OStream>::provide(
     packer.pack(options);
     packer.pack(name);
 
+    return issue_register(request_id, buffer, std::make_shared<wamp_register_request>(procedure));
+}
+
+template<typename IStream, typename OStream>
+template<typename Signature, typename Function>
+boost::future<wamp_registration> wamp_session<IStream, OStream>::provide(
+        const std::string& name, Function procedure, const provide_options& options)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+
+    // [REGISTER, Request|id, Options|dict, Procedure|uri]
+    packer.pack_array(4);
+    packer.pack(static_cast<int>(message_type::REGISTER));
+    packer.pack(request_id);
+    packer.pack(options);
+    packer.pack(name);
+
+    return issue_register(request_id, buffer, std::make_shared<wamp_register_request>(
+            make_typed_procedure<Signature>(std::move(procedure))));
+}
+
+template<typename IStream, typename OStream>
+boost::future<wamp_registration> wamp_session<IStream, OStream>::issue_register(
+        uint64_t request_id,
+        const std::shared_ptr<msgpack::sbuffer>& buffer,
+        const std::shared_ptr<wamp_register_request>& register_request)
+{
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-    auto register_request = std::make_shared<wamp_register_request>(procedure);
 
     m_io.dispatch([=]() {
         auto shared_self = weak_self.lock();
@@ -340,6 +464,25 @@ boost::future<wamp_registration> wamp_session<IStream, OStream>::provide(
     return register_request->response().get_future();
 }
 
+template<typename IStream, typename OStream>
+boost::future<wamp_registration> wamp_session<IStream, OStream>::provide(
+        const std::string& name,
+        const wamp_procedure& procedure,
+        const provide_options& options,
+        const wamp_invocation_options& invocation_options)
+{
+    if (!invocation_options.executor()) {
+        return provide(name, procedure, options);
+    }
+
+    auto queue = std::make_shared<wamp_invocation_queue>(procedure, invocation_options);
+    auto queued_procedure = [queue](wamp_invocation invocation) {
+        queue->push(invocation);
+    };
+
+    return provide(name, queued_procedure, options);
+}
+
 template<typename IStream, typename OStream>
 void wamp_session<IStream, OStream>::publish(const std::string& topic)
 {
@@ -437,21 +580,552 @@ void wamp_session<IStream, OStream>::publish(
 }
 
 template<typename IStream, typename OStream>
-boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(const std::string& procedure)
+void wamp_session<IStream, OStream>::publish_raw(const std::string& topic,
+        const wamp_msgpack_span& arguments, const wamp_msgpack_span& kw_arguments)
+{
+    std::size_t payload_elements = detail::raw_payload_elements(arguments, kw_arguments);
+
+    auto buffer = std::make_shared<msgpack::sbuffer>(
+            topic.size() + arguments.size() + kw_arguments.size() + 32);
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+
+    // [PUBLISH, Request|id, Options|dict, Topic|uri, Arguments|list, ArgumentsKw|dict]
+    packer.pack_array(4 + payload_elements);
+    packer.pack(static_cast<int>(message_type::PUBLISH));
+    packer.pack(request_id);
+    packer.pack_map(0);
+    packer.pack(topic);
+    detail::write_raw_payload(*buffer, arguments, kw_arguments);
+
+    dispatch_publish(buffer);
+}
+
+template<typename IStream, typename OStream>
+wamp_prepared_topic wamp_session<IStream, OStream>::prepare_topic(
+        const std::string& topic, const publish_options& options) const
+{
+    return wamp_prepared_topic(topic, options);
+}
+
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::publish(const wamp_prepared_topic& topic)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+
+    // [PUBLISH, Request|id, Options|dict, Topic|uri]
+    packer.pack_array(4);
+    packer.pack(static_cast<int>(message_type::PUBLISH));
+    packer.pack(request_id);
+    buffer->write(topic.encoded().data(), topic.encoded().size());
+
+    dispatch_publish(buffer);
+}
+
+template<typename IStream, typename OStream>
+template <typename List>
+void wamp_session<IStream, OStream>::publish(const wamp_prepared_topic& topic, const List& arguments)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+
+    // [PUBLISH, Request|id, Options|dict, Topic|uri, Arguments|list]
+    packer.pack_array(5);
+    packer.pack(static_cast<int>(message_type::PUBLISH));
+    packer.pack(request_id);
+    buffer->write(topic.encoded().data(), topic.encoded().size());
+    packer.pack(arguments);
+
+    dispatch_publish(buffer);
+}
+
+template<typename IStream, typename OStream>
+template <typename List, typename Map>
+void wamp_session<IStream, OStream>::publish(
+        const wamp_prepared_topic& topic, const List& arguments, const Map& kw_arguments)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+
+    // [PUBLISH, Request|id, Options|dict, Topic|uri, Arguments|list, ArgumentsKw|dict]
+    packer.pack_array(6);
+    packer.pack(static_cast<int>(message_type::PUBLISH));
+    packer.pack(request_id);
+    buffer->write(topic.encoded().data(), topic.encoded().size());
+    packer.pack(arguments);
+    packer.pack(kw_arguments);
+
+    dispatch_publish(buffer);
+}
+
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::dispatch_publish(const std::shared_ptr<msgpack::sbuffer>& buffer)
+{
+    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+
+    m_io.dispatch([=]() {
+        auto shared_self = weak_self.lock();
+        if (!shared_self) {
+            return;
+        }
+
+        if (!m_session_id) {
+            throw no_session_error();
+        }
+
+        send(buffer);
+    });
+}
+
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::publish_batch(wamp_publish_batch batch)
+{
+    if (batch.empty()) {
+        return;
+    }
+
+    uint64_t first_request_id = m_request_id.fetch_add(batch.size()) + 1;
+    batch.frames().set_request_ids(first_request_id);
+
+    auto frames = batch.frames().frames();
+    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+
+    m_io.dispatch([=]() {
+        auto shared_self = weak_self.lock();
+        if (!shared_self) {
+            return;
+        }
+
+        if (!m_session_id) {
+            throw no_session_error();
+        }
+
+        send_frames(frames);
+    });
+}
+
+template<typename IStream, typename OStream>
+template <typename Range>
+void wamp_session<IStream, OStream>::publish_batch(const std::string& topic, const Range& payloads)
+{
+    wamp_publish_batch batch;
+    for (const auto& arguments : payloads) {
+        batch.publish(topic, arguments);
+    }
+
+    publish_batch(std::move(batch));
+}
+
+template<typename IStream, typename OStream>
+boost::future<wamp_publication> wamp_session<IStream, OStream>::publish_acknowledged(
+        const std::string& topic)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+
+    // [PUBLISH, Request|id, Options|dict, Topic|uri]
+    packer.pack_array(4);
+    packer.pack(static_cast<int>(message_type::PUBLISH));
+    packer.pack(request_id);
+    packer.pack_map(1);
+    packer.pack(std::string("acknowledge"));
+    packer.pack(true);
+    packer.pack(topic);
+
+    return issue_publish(request_id, buffer);
+}
+
+template<typename IStream, typename OStream>
+template <typename List>
+boost::future<wamp_publication> wamp_session<IStream, OStream>::publish_acknowledged(
+        const std::string& topic, const List& arguments)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+
+    // [PUBLISH, Request|id, Options|dict, Topic|uri, Arguments|list]
+    packer.pack_array(5);
+    packer.pack(static_cast<int>(message_type::PUBLISH));
+    packer.pack(request_id);
+    packer.pack_map(1);
+    packer.pack(std::string("acknowledge"));
+    packer.pack(true);
+    packer.pack(topic);
+    packer.pack(arguments);
+
+    return issue_publish(request_id, buffer);
+}
+
+template<typename IStream, typename OStream>
+template <typename List, typename Map>
+boost::future<wamp_publication> wamp_session<IStream, OStream>::publish_acknowledged(
+        const std::string& topic, const List& arguments, const Map& kw_arguments)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+
+    // [PUBLISH, Request|id, Options|dict, Topic|uri, Arguments|list, ArgumentsKw|dict]
+    packer.pack_array(6);
+    packer.pack(static_cast<int>(message_type::PUBLISH));
+    packer.pack(request_id);
+    packer.pack_map(1);
+    packer.pack(std::string("acknowledge"));
+    packer.pack(true);
+    packer.pack(topic);
+    packer.pack(arguments);
+    packer.pack(kw_arguments);
+
+    return issue_publish(request_id, buffer);
+}
+
+template<typename IStream, typename OStream>
+boost::future<wamp_publication> wamp_session<IStream, OStream>::issue_publish(
+        uint64_t request_id, const std::shared_ptr<msgpack::sbuffer>& buffer)
+{
+    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+    auto publication = std::make_shared<boost::promise<wamp_publication>>();
+
+    m_io.dispatch([=]() {
+        auto shared_self = weak_self.lock();
+        if (!shared_self) {
+            return;
+        }
+
+        if (!m_session_id) {
+            throw no_session_error();
+        }
+
+        m_publish_requests.emplace(request_id, publication);
+
+        send(buffer);
+    });
+
+    return publication->get_future();
+}
+
+template<typename IStream, typename OStream>
+boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(const std::string& procedure)
+{
+    return call(procedure, wamp_call_options());
+}
+
+template<typename IStream, typename OStream>
+boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(
+        const std::string& procedure, const wamp_call_options& options)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+    wamp_call_options call_options = effective_call_options(options);
+
+    // [CALL, Request|id, Options|dict, Procedure|uri]
+    packer.pack_array(4);
+    packer.pack(static_cast<int>(message_type::CALL));
+    packer.pack(request_id);
+    packer.pack(call_options);
+    packer.pack(procedure);
+
+    return issue_call(request_id, buffer, call_options);
+}
+
+template<typename IStream, typename OStream>
+template<typename List>
+boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(
+        const std::string& procedure, const List& arguments)
+{
+    return call(procedure, arguments, wamp_call_options());
+}
+
+template<typename IStream, typename OStream>
+template<typename List>
+boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(
+        const std::string& procedure, const List& arguments, const wamp_call_options& options)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+    wamp_call_options call_options = effective_call_options(options);
+
+    // [CALL, Request|id, Options|dict, Procedure|uri, Arguments|list]
+    packer.pack_array(5);
+    packer.pack(static_cast<int>(message_type::CALL));
+    packer.pack(request_id);
+    packer.pack(call_options);
+    packer.pack(procedure);
+    packer.pack(arguments);
+
+    return issue_call(request_id, buffer, call_options);
+}
+
+template<typename IStream, typename OStream>
+template<typename List, typename Map>
+boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(
+        const std::string& procedure, const List& arguments, const Map& kw_arguments)
+{
+    return call(procedure, arguments, kw_arguments, wamp_call_options());
+}
+
+template<typename IStream, typename OStream>
+template<typename List, typename Map>
+boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(
+        const std::string& procedure, const List& arguments, const Map& kw_arguments,
+        const wamp_call_options& options)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+    wamp_call_options call_options = effective_call_options(options);
+
+    // [CALL, Request|id, Options|dict, Procedure|uri, Arguments|list, ArgumentsKw|dict]
+    packer.pack_array(6);
+    packer.pack(static_cast<int>(message_type::CALL));
+    packer.pack(request_id);
+    packer.pack(call_options);
+    packer.pack(procedure);
+    packer.pack(arguments);
+    packer.pack(kw_arguments);
+
+    return issue_call(request_id, buffer, call_options);
+}
+
+template<typename IStream, typename OStream>
+boost::future<wamp_call_result> wamp_session<IStream, OStream>::call_raw(
+        const std::string& procedure, const wamp_msgpack_span& arguments,
+        const wamp_msgpack_span& kw_arguments, const wamp_call_options& options)
+{
+    std::size_t payload_elements = detail::raw_payload_elements(arguments, kw_arguments);
+
+    auto buffer = std::make_shared<msgpack::sbuffer>(
+            procedure.size() + arguments.size() + kw_arguments.size() + 64);
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+    wamp_call_options call_options = effective_call_options(options);
+
+    // [CALL, Request|id, Options|dict, Procedure|uri, Arguments|list, ArgumentsKw|dict]
+    packer.pack_array(4 + payload_elements);
+    packer.pack(static_cast<int>(message_type::CALL));
+    packer.pack(request_id);
+    packer.pack(call_options);
+    packer.pack(procedure);
+    detail::write_raw_payload(*buffer, arguments, kw_arguments);
+
+    return issue_call(request_id, buffer, call_options);
+}
+
+template<typename IStream, typename OStream>
+wamp_prepared_call wamp_session<IStream, OStream>::prepare_call(
+        const std::string& procedure, const wamp_call_options& options) const
+{
+    return wamp_prepared_call(procedure, effective_call_options(options));
+}
+
+template<typename IStream, typename OStream>
+boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(const wamp_prepared_call& procedure)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+
+    // [CALL, Request|id, Options|dict, Procedure|uri]
+    packer.pack_array(4);
+    packer.pack(static_cast<int>(message_type::CALL));
+    packer.pack(request_id);
+    buffer->write(procedure.encoded().data(), procedure.encoded().size());
+
+    return issue_call(request_id, buffer, procedure.options());
+}
+
+template<typename IStream, typename OStream>
+template<typename List>
+boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(
+        const wamp_prepared_call& procedure, const List& arguments)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+
+    // [CALL, Request|id, Options|dict, Procedure|uri, Arguments|list]
+    packer.pack_array(5);
+    packer.pack(static_cast<int>(message_type::CALL));
+    packer.pack(request_id);
+    buffer->write(procedure.encoded().data(), procedure.encoded().size());
+    packer.pack(arguments);
+
+    return issue_call(request_id, buffer, procedure.options());
+}
+
+template<typename IStream, typename OStream>
+template<typename List, typename Map>
+boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(
+        const wamp_prepared_call& procedure, const List& arguments, const Map& kw_arguments)
+{
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
+    uint64_t request_id = ++m_request_id;
+
+    // [CALL, Request|id, Options|dict, Procedure|uri, Arguments|list, ArgumentsKw|dict]
+    packer.pack_array(6);
+    packer.pack(static_cast<int>(message_type::CALL));
+    packer.pack(request_id);
+    buffer->write(procedure.encoded().data(), procedure.encoded().size());
+    packer.pack(arguments);
+    packer.pack(kw_arguments);
+
+    return issue_call(request_id, buffer, procedure.options());
+}
+
+template<typename IStream, typename OStream>
+boost::future<wamp_call_batch_results> wamp_session<IStream, OStream>::call_many(wamp_call_batch batch)
+{
+    if (batch.empty()) {
+        return boost::make_ready_future(wamp_call_batch_results());
+    }
+
+    std::size_t count = batch.size();
+    uint64_t first_request_id = m_request_id.fetch_add(count) + 1;
+    batch.frames().set_request_ids(first_request_id);
+
+    auto frames = batch.frames().frames();
+    auto calls = std::make_shared<std::vector<std::pair<std::shared_ptr<wamp_call>, std::chrono::milliseconds>>>();
+    std::vector<boost::future<wamp_call_result>> results;
+
+    calls->reserve(count);
+    results.reserve(count);
+    for (const wamp_call_options& options : batch.options()) {
+        wamp_call_options call_options = effective_call_options(options);
+        auto call = std::make_shared<wamp_call>();
+        call->set_progress_handler(call_options.progress_handler());
+        calls->push_back(std::make_pair(call, call_options.timeout()));
+        results.push_back(call->result().get_future());
+    }
+
+    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
+    m_outstanding_calls += count;
+
+    m_io.dispatch([=]() {
+        auto shared_self = weak_self.lock();
+        if (!shared_self) {
+            return;
+        }
+
+        if (!m_session_id) {
+            m_outstanding_calls -= count;
+            throw no_session_error();
+        }
+
+        uint64_t request_id = first_request_id;
+        for (const auto& call : *calls) {
+            m_calls.emplace(request_id, call.first);
+            if (call.second.count() > 0) {
+                call.first->set_timeout_tick(schedule_call_timeout(request_id, call.second));
+            }
+            ++request_id;
+        }
+
+        send_frames(frames);
+    });
+
+    return boost::when_all(results.begin(), results.end());
+}
+
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::set_lazy_payloads(bool lazy)
+{
+    m_lazy_payloads = lazy;
+}
+
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::set_receive_buffer_limit(std::size_t max_capacity)
+{
+    m_receive_buffer_limit = max_capacity;
+}
+
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::set_lean_mode(bool lean)
+{
+    m_lean = lean;
+    if (lean) {
+        set_receive_buffer_limit(0);
+        set_zone_pool_limit(0);
+        std::vector<char>().swap(m_message_buffer);
+        if (m_call_timeouts && m_call_timeouts->empty()) {
+            m_call_timeouts.reset();
+        }
+    }
+}
+
+template<typename IStream, typename OStream>
+std::size_t wamp_session<IStream, OStream>::memory_footprint() const
+{
+    std::size_t footprint = sizeof(*this)
+            + m_message_buffer.capacity()
+            + m_zone_pool.retained_bytes()
+            + detail::table_footprint(m_calls)
+            + detail::table_footprint(m_canceled_calls)
+            + detail::table_footprint(m_publish_requests)
+            + detail::table_footprint(m_subscribe_requests)
+            + detail::table_footprint(m_unsubscribe_requests)
+            + detail::table_footprint(m_subscription_handlers)
+            + detail::table_footprint(m_typed_subscription_handlers)
+            + detail::table_footprint(m_register_requests)
+            + detail::table_footprint(m_procedures)
+            + detail::table_footprint(m_typed_procedures);
+
+    if (m_call_timeouts) {
+        footprint += m_call_timeouts->memory_footprint();
+    }
+
+    return footprint;
+}
+
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::set_zone_pool_limit(std::size_t max_retained_bytes)
+{
+    m_zone_pool.set_max_retained_bytes(max_retained_bytes);
+}
+
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::set_default_call_timeout(const std::chrono::milliseconds& timeout)
+{
+    m_default_call_timeout = timeout;
+}
+
+template<typename IStream, typename OStream>
+std::size_t wamp_session<IStream, OStream>::outstanding_calls() const
+{
+    return m_outstanding_calls;
+}
+
+template<typename IStream, typename OStream>
+wamp_call_options wamp_session<IStream, OStream>::effective_call_options(
+        const wamp_call_options& options) const
 {
-    auto buffer = std::make_shared<msgpack::sbuffer>();
-    msgpack::packer<msgpack::sbuffer> packer(*buffer);
-    uint64_t request_id = ++m_request_id;
+    wamp_call_options call_options(options);
+    if (call_options.timeout().count() <= 0) {
+        call_options.set_timeout(m_default_call_timeout);
+    }
 
-    // [CALL, Request|id, Options|dict, Procedure|uri]
-    packer.pack_array(4);
-    packer.pack(static_cast<int>(message_type::CALL));
-    packer.pack(request_id);
-    packer.pack_map(0);
-    packer.pack(procedure);
+    return call_options;
+}
 
+template<typename IStream, typename OStream>
+boost::future<wamp_call_result> wamp_session<IStream, OStream>::issue_call(
+        uint64_t request_id,
+        const std::shared_ptr<msgpack::sbuffer>& buffer,
+        const wamp_call_options& options)
+{
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
     auto call = std::make_shared<wamp_call>();
+    call->set_progress_handler(options.progress_handler());
+    std::chrono::milliseconds timeout = options.timeout();
+    ++m_outstanding_calls;
 
     m_io.dispatch([=]() {
         auto shared_self = weak_self.lock();
@@ -460,11 +1134,16 @@ boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(const std::
         }
 
         if (!m_session_id) {
+            --m_outstanding_calls;
             throw no_session_error();
         }
 
         m_calls.emplace(request_id, call);
 
+        if (timeout.count() > 0) {
+            call->set_timeout_tick(schedule_call_timeout(request_id, timeout));
+        }
+
         send(buffer);
     });
 
@@ -472,80 +1151,182 @@ boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(const std::
 }
 
 template<typename IStream, typename OStream>
-template<typename List>
-boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(
-        const std::string& procedure, const List& arguments)
+uint64_t wamp_session<IStream, OStream>::call_timeout_tick() const
 {
-    auto buffer = std::make_shared<msgpack::sbuffer>();
-    msgpack::packer<msgpack::sbuffer> packer(*buffer);
-    uint64_t request_id = ++m_request_id;
+    return static_cast<uint64_t>(
+            (std::chrono::steady_clock::now() - m_call_timeout_epoch) / m_call_timeout_resolution);
+}
 
-    // [CALL, Request|id, Options|dict, Procedure|uri, Arguments|list]
-    packer.pack_array(5);
-    packer.pack(static_cast<int>(message_type::CALL));
-    packer.pack(request_id);
-    packer.pack_map(0);
-    packer.pack(procedure);
-    packer.pack(arguments);
+template<typename IStream, typename OStream>
+uint64_t wamp_session<IStream, OStream>::schedule_call_timeout(
+        uint64_t request_id, const std::chrono::milliseconds& timeout)
+{
+    // Round up so that a call never times out early.
+    uint64_t ticks = static_cast<uint64_t>(
+            (timeout + m_call_timeout_resolution - std::chrono::milliseconds(1)) / m_call_timeout_resolution);
+
+    // An idle wheel lags behind the clock; catch it up without expiring anything.
+    uint64_t now = call_timeout_tick();
+    if (!m_call_timeouts) {
+        m_call_timeouts.reset(new wamp_timing_wheel());
+    }
+    if (m_call_timeouts->empty()) {
+        std::vector<uint64_t> expired;
+        m_call_timeouts->advance(now, expired);
+    }
+
+    m_call_timeouts->schedule(request_id, now + ticks);
+
+    if (!m_call_timer_armed) {
+        arm_call_timer();
+    }
+
+    return now + ticks;
+}
+
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::cancel_call_timeout(uint64_t request_id, const wamp_call& call)
+{
+    if (call.timeout_tick() != 0) {
+        cancel_timeout(request_id, call.timeout_tick());
+    }
+}
+
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::cancel_timeout(uint64_t entry, uint64_t tick)
+{
+    if (!m_call_timeouts) {
+        return;
+    }
+
+    m_call_timeouts->cancel(entry, tick);
+    if (!m_call_timeouts->empty()) {
+        return;
+    }
+
+    // Nothing left to time out: don't keep waking up every tick.
+    if (m_call_timer_armed) {
+        m_call_timer.cancel();
+        m_call_timer_armed = false;
+    }
+    if (m_lean) {
+        m_call_timeouts.reset();
+    }
+}
 
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::arm_call_timer()
+{
     auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-    auto call = std::make_shared<wamp_call>();
 
-    m_io.dispatch([=]() {
+    m_call_timer_armed = true;
+    m_call_timer.expires_from_now(m_call_timeout_resolution);
+    m_call_timer.async_wait([=](const boost::system::error_code& error) {
         auto shared_self = weak_self.lock();
         if (!shared_self) {
             return;
         }
 
-        if (!m_session_id) {
-            throw no_session_error();
+        // Whoever cancelled the timer has already cleared m_call_timer_armed, and
+        // may have armed it again since.
+        if (error == boost::asio::error::operation_aborted) {
+            return;
         }
 
-        m_calls.emplace(request_id, call);
+        m_call_timer_armed = false;
+        if (m_stopped || !m_call_timeouts) {
+            return;
+        }
 
-        send(buffer);
+        std::vector<uint64_t> expired;
+        m_call_timeouts->advance(call_timeout_tick(), expired);
+        for (uint64_t entry : expired) {
+            if (entry & CANCELED_CALL_TAG) {
+                m_canceled_calls.erase(entry & ~CANCELED_CALL_TAG);
+            } else {
+                expire_call(entry);
+            }
+        }
+
+        // Expiring a call schedules how long to wait for its cancellation, which
+        // may have armed the timer already.
+        if (!m_call_timeouts->empty()) {
+            if (!m_call_timer_armed) {
+                arm_call_timer();
+            }
+        } else if (m_lean) {
+            m_call_timeouts.reset();
+        }
     });
+}
 
-    return call->result().get_future();
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::fail_outstanding_calls()
+{
+    // Nothing can answer them once the streams are closed.
+    for (auto& outstanding : m_calls) {
+        outstanding.second->result().set_exception(boost::copy_exception(no_session_error()));
+    }
+
+    m_calls.clear();
+    m_outstanding_calls = 0;
+    m_canceled_calls.clear();
+    m_call_timeouts.reset();
+
+    for (auto& publication : m_publish_requests) {
+        publication.second->set_exception(boost::copy_exception(no_session_error()));
+    }
+    m_publish_requests.clear();
 }
 
 template<typename IStream, typename OStream>
-template<typename List, typename Map>
-boost::future<wamp_call_result> wamp_session<IStream, OStream>::call(
-        const std::string& procedure, const List& arguments, const Map& kw_arguments)
+void wamp_session<IStream, OStream>::expire_call(uint64_t request_id)
 {
-    auto buffer = std::make_shared<msgpack::sbuffer>();
-    msgpack::packer<msgpack::sbuffer> packer(*buffer);
-    uint64_t request_id = ++m_request_id;
+    // A call that is no longer outstanding has nothing left to time out.
+    auto call_itr = m_calls.find(request_id);
+    if (call_itr == m_calls.end()) {
+        return;
+    }
 
-    // [CALL, Request|id, Options|dict, Procedure|uri, Arguments|list, ArgumentsKw|dict]
-    packer.pack_array(6);
-    packer.pack(static_cast<int>(message_type::CALL));
-    packer.pack(request_id);
-    packer.pack_map(0);
-    packer.pack(procedure);
-    packer.pack(arguments);
-    packer.pack(kw_arguments);
+    call_itr->second->result().set_exception(boost::copy_exception(timeout_error("call timed out")));
+    m_calls.erase(call_itr);
+    --m_outstanding_calls;
 
-    auto weak_self = std::weak_ptr<wamp_session>(this->shared_from_this());
-    auto call = std::make_shared<wamp_call>();
+    if (!m_session_id) {
+        return;
+    }
 
-    m_io.dispatch([=]() {
-        auto shared_self = weak_self.lock();
-        if (!shared_self) {
-            return;
-        }
+    // The dealer answers the cancellation (or the original call) with an ERROR
+    // or RESULT that has to be ignored when it arrives.
+    m_canceled_calls[request_id] =
+            schedule_call_timeout(request_id | CANCELED_CALL_TAG, m_canceled_call_retention);
 
-        if (!m_session_id) {
-            throw no_session_error();
-        }
+    auto buffer = std::make_shared<msgpack::sbuffer>();
+    msgpack::packer<msgpack::sbuffer> packer(*buffer);
 
-        m_calls.emplace(request_id, call);
+    // [CANCEL, CALL.Request|id, Options|dict]
+    packer.pack_array(3);
+    packer.pack(static_cast<int>(message_type::CANCEL));
+    packer.pack(request_id);
+    packer.pack_map(1);
+    packer.pack(std::string("mode"));
+    packer.pack(std::string("killnowait"));
 
-        send(buffer);
-    });
+    send(buffer);
+}
 
-    return call->result().get_future();
+template<typename IStream, typename OStream>
+bool wamp_session<IStream, OStream>::forget_canceled_call(uint64_t request_id)
+{
+    auto canceled_itr = m_canceled_calls.find(request_id);
+    if (canceled_itr == m_canceled_calls.end()) {
+        return false;
+    }
+
+    uint64_t tick = canceled_itr->second;
+    m_canceled_calls.erase(canceled_itr);
+    cancel_timeout(request_id | CANCELED_CALL_TAG, tick);
+    return true;
 }
 
 template<typename IStream, typename OStream>
@@ -553,6 +1334,7 @@ void wamp_session<IStream, OStream>::handleRxError(const boost::system::error_co
     //specifically catch any non-error returns
     if(error != boost::asio::error::operation_aborted){
         std::cerr << "caught error" <<std::endl;
+        fail_outstanding_calls();
         m_session_leave.set_value("socket closed");
         leave().wait();
         stop().wait();
@@ -670,6 +1452,22 @@ void wamp_session<IStream, OStream>::process_error(const wamp_message& message)
 
     switch (request_type) {
 
+        case message_type::PUBLISH:
+            {
+                //
+                // process PUBLISH ERROR
+                //
+                auto publish_itr = m_publish_requests.find(request_id);
+
+                if (publish_itr != m_publish_requests.end()) {
+                    publish_itr->second->set_exception(boost::copy_exception(std::runtime_error(error)));
+                    m_publish_requests.erase(publish_itr);
+                } else {
+                    throw protocol_error("bogus ERROR message for non-pending PUBLISH request ID");
+                }
+            }
+            break;
+
         case message_type::CALL:
             {
                 //
@@ -682,8 +1480,11 @@ void wamp_session<IStream, OStream>::process_error(const wamp_message& message)
                     // FIXME: forward all error info .. also not sure if this is the correct
                     // way to use set_exception()
                     call_itr->second->result().set_exception(boost::copy_exception(std::runtime_error(error)));
+                    cancel_call_timeout(request_id, *call_itr->second);
+                    m_calls.erase(call_itr);
+                    --m_outstanding_calls;
 
-                } else {
+                } else if (!forget_canceled_call(request_id)) {
                     throw protocol_error("bogus ERROR message for non-pending CALL request ID");
                 }
             }
@@ -700,7 +1501,8 @@ void wamp_session<IStream, OStream>::process_error(const wamp_message& message)
 template<typename IStream, typename OStream>
 void wamp_session<IStream, OStream>::process_invocation(
         const wamp_message& message,
-        msgpack::unique_ptr<msgpack::zone>&& zone)
+        const std::shared_ptr<msgpack::zone>& zone,
+        const std::shared_ptr<wamp_lazy_payload>& payload)
 {
     // [INVOCATION, Request|id, REGISTERED.Registration|id, Details|dict]
     // [INVOCATION, Request|id, REGISTERED.Registration|id, Details|dict, CALL.Arguments|list]
@@ -720,6 +1522,34 @@ void wamp_session<IStream, OStream>::process_invocation(
     }
     uint64_t registration_id = message[2].as<uint64_t>();
 
+    // Typed procedures decode their arguments and pack their reply themselves,
+    // right here on the io thread.
+    auto typed_procedure_itr = m_typed_procedures.find(registration_id);
+    if (typed_procedure_itr != m_typed_procedures.end()) {
+        if (message[3].type != msgpack::type::MAP) {
+            throw protocol_error("INVOCATION.Details must be a map");
+        }
+
+        msgpack::object arguments;
+        if (message.size() > 4) {
+            if (message[4].type != msgpack::type::ARRAY) {
+                throw protocol_error("INVOCATION.Arguments must be an array/vector");
+            }
+            arguments = message[4];
+        } else if (payload) {
+            arguments = payload->arguments();
+        }
+
+        if (m_debug) {
+            std::cerr << "Invoking typed procedure registered under " << registration_id << std::endl;
+        }
+
+        auto buffer = std::make_shared<msgpack::sbuffer>();
+        typed_procedure_itr->second(request_id, arguments, *buffer);
+        send(buffer);
+        return;
+    }
+
     auto procedure_itr = m_procedures.find(registration_id);
     if (procedure_itr != m_procedures.end()) {
         wamp_invocation invocation = std::make_shared<wamp_invocation_impl>();
@@ -745,8 +1575,10 @@ void wamp_session<IStream, OStream>::process_invocation(
             }
         }
 
-        invocation->set_zone(std::move(*zone));
-        zone.reset();
+        invocation->set_zone(zone);
+        if (payload) {
+            invocation->set_lazy_payload(payload);
+        }
 
         auto weak_this = std::weak_ptr<wamp_session>(this->shared_from_this());
 
@@ -770,6 +1602,32 @@ void wamp_session<IStream, OStream>::process_invocation(
 
         invocation->set_send_result_fn(std::move(send_result_fn));
 
+        auto send_progress_fn = [weak_this] (const std::shared_ptr<msgpack::sbuffer>& buffer) -> boost::future<void> {
+            // Resolved once the chunk has been written, which lets a producer
+            // running on another thread keep pace with the transport.
+            auto written = std::make_shared<boost::promise<void>>();
+
+            auto shared_this = weak_this.lock();
+            if (!shared_this) {
+                written->set_exception(boost::copy_exception(no_session_error()));
+                return written->get_future();
+            }
+
+            shared_this->m_io.dispatch([weak_this, buffer, written] {
+                auto shared_this = weak_this.lock();
+                if (!shared_this) {
+                    written->set_exception(boost::copy_exception(no_session_error()));
+                    return;
+                }
+                shared_this->send(buffer);
+                written->set_value();
+            });
+
+            return written->get_future();
+        };
+
+        invocation->set_send_progress_fn(std::move(send_progress_fn));
+
         try {
             if (m_debug) {
                 std::cerr << "Invoking procedure registered under " << registration_id << std::endl;
@@ -801,7 +1659,9 @@ void wamp_session<IStream, OStream>::process_invocation(
 
 template<typename IStream, typename OStream>
 void wamp_session<IStream, OStream>::process_call_result(
-        const wamp_message& message, msgpack::unique_ptr<msgpack::zone>&& zone)
+        const wamp_message& message,
+        const std::shared_ptr<msgpack::zone>& zone,
+        const std::shared_ptr<wamp_lazy_payload>& payload)
 {
     // [RESULT, CALL.Request|id, Details|dict]
     // [RESULT, CALL.Request|id, Details|dict, YIELD.Arguments|list]
@@ -822,7 +1682,10 @@ void wamp_session<IStream, OStream>::process_call_result(
             throw protocol_error("RESULT - Details must be a dictionary");
         }
 
-        wamp_call_result result(std::move(zone));
+        wamp_call_result result(zone);
+        if (payload) {
+            result.set_lazy_payload(payload);
+        }
         if (message.size() > 3) {
             if (message[3].type != msgpack::type::ARRAY) {
                 throw protocol_error("RESULT - YIELD.Arguments must be a list");
@@ -836,9 +1699,68 @@ void wamp_session<IStream, OStream>::process_call_result(
                 result.set_kw_arguments(message[4]);
             }
         }
+
+        // A progressive result is handed to the progress handler and dropped
+        // with its zone right after; the call stays outstanding.
+        const msgpack::object* progress = find_detail(message[2], "progress");
+        if (progress && progress->type == msgpack::type::BOOLEAN && progress->via.boolean) {
+            const wamp_progress_handler& handler = call_itr->second->progress_handler();
+            if (!handler) {
+                throw protocol_error("RESULT - progressive result for a call that did not request one");
+            }
+
+            try {
+                handler(result);
+            } catch (...) {
+                if (m_debug) {
+                    std::cerr << "Warning: progress handler threw exception" << std::endl;
+                }
+            }
+            return;
+        }
+
         call_itr->second->set_result(std::move(result));
+        cancel_call_timeout(request_id, *call_itr->second);
+        m_calls.erase(call_itr);
+        --m_outstanding_calls;
+    } else {
+        // A canceled call may still be streaming progressive results; it is only
+        // forgotten with the final RESULT (or the ERROR) the dealer sends.
+        const msgpack::object* progress = find_detail(message[2], "progress");
+        bool progressive = progress && progress->type == msgpack::type::BOOLEAN && progress->via.boolean;
+        bool canceled = progressive
+                ? m_canceled_calls.count(request_id) != 0
+                : forget_canceled_call(request_id);
+        if (!canceled) {
+            throw protocol_error("bogus RESULT message for non-pending request ID");
+        }
+    }
+}
+
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::process_published(const wamp_message& message)
+{
+    // [PUBLISHED, PUBLISH.Request|id, Publication|id]
+
+    if (message.size() != 3) {
+        throw protocol_error("PUBLISHED - length must be 3");
+    }
+
+    if (message[1].type != msgpack::type::POSITIVE_INTEGER) {
+        throw protocol_error("PUBLISHED - PUBLISH.Request must be an integer");
+    }
+
+    uint64_t request_id = message[1].as<uint64_t>();
+    auto publish_itr = m_publish_requests.find(request_id);
+    if (publish_itr != m_publish_requests.end()) {
+        if (message[2].type != msgpack::type::POSITIVE_INTEGER) {
+            throw protocol_error("PUBLISHED - Publication must be an integer");
+        }
+
+        publish_itr->second->set_value(wamp_publication(message[2].as<uint64_t>()));
+        m_publish_requests.erase(publish_itr);
     } else {
-        throw protocol_error("bogus RESULT message for non-pending request ID");
+        throw protocol_error("PUBLISHED - no pending request ID");
     }
 }
 
@@ -862,7 +1784,12 @@ void wamp_session<IStream, OStream>::process_subscribed(const wamp_message& mess
         }
 
         uint64_t subscription_id = message[2].as<uint64_t>();
-        m_subscription_handlers.insert(std::make_pair(subscription_id, subscribe_request_itr->second->handler()));
+        if (subscribe_request_itr->second->typed_handler()) {
+            m_typed_subscription_handlers.insert(
+                    std::make_pair(subscription_id, subscribe_request_itr->second->typed_handler()));
+        } else {
+            m_subscription_handlers.insert(std::make_pair(subscription_id, subscribe_request_itr->second->handler()));
+        }
         subscribe_request_itr->second->set_response(wamp_subscription(subscription_id));
         m_subscribe_requests.erase(request_id);
     } else {
@@ -893,7 +1820,10 @@ void wamp_session<IStream, OStream>::process_unsubscribed(const wamp_message& me
 }
 
 template<typename IStream, typename OStream>
-void wamp_session<IStream, OStream>::process_event(const wamp_message& message)
+void wamp_session<IStream, OStream>::process_event(
+        const wamp_message& message,
+        const std::shared_ptr<msgpack::zone>& zone,
+        const std::shared_ptr<wamp_lazy_payload>& payload)
 {
     // [EVENT, SUBSCRIBED.Subscription|id, PUBLISHED.Publication|id, Details|dict]
     // [EVENT, SUBSCRIBED.Subscription|id, PUBLISHED.Publication|id, Details|dict, PUBLISH.Arguments|list]
@@ -911,9 +1841,11 @@ void wamp_session<IStream, OStream>::process_event(const wamp_message& message)
 
     auto subscription_handlers_itr = m_subscription_handlers.lower_bound(subscription_id);
     auto subscription_handlers_end = m_subscription_handlers.upper_bound(subscription_id);
+    auto typed_handlers_itr = m_typed_subscription_handlers.lower_bound(subscription_id);
+    auto typed_handlers_end = m_typed_subscription_handlers.upper_bound(subscription_id);
 
-    if (subscription_handlers_itr != m_subscription_handlers.end() &&
-            subscription_handlers_itr != subscription_handlers_end) {
+    if (subscription_handlers_itr != subscription_handlers_end ||
+            typed_handlers_itr != typed_handlers_end) {
 
         if (message[2].type != msgpack::type::POSITIVE_INTEGER) {
             throw protocol_error("EVENT - PUBLISHED.Publication must be an id");
@@ -925,17 +1857,56 @@ void wamp_session<IStream, OStream>::process_event(const wamp_message& message)
             throw protocol_error("EVENT - Details must be a dictionary");
         }
 
-        wamp_event event;
         if (message.size() > 4) {
             if (message[4].type != msgpack::type::ARRAY) {
                 throw protocol_error("EVENT - EVENT.Arguments must be a list");
             }
-            event.set_arguments(message[4]);
 
             if (message.size() > 5) {
                 if (message[5].type != msgpack::type::MAP) {
                     throw protocol_error("EVENT - EVENT.ArgumentsKw must be a dictionary");
                 }
+            }
+        }
+
+        // Typed handlers decode the positional payload themselves, while the
+        // zone is still owned here.
+        msgpack::object arguments;
+        if (message.size() > 4) {
+            arguments = message[4];
+        } else if (payload) {
+            arguments = payload->arguments();
+        }
+
+        while (typed_handlers_itr != typed_handlers_end) {
+            try {
+                (typed_handlers_itr->second)(arguments);
+            } catch (const std::exception& e) {
+                if (m_debug) {
+                    std::cerr << "Warning: typed event handler threw exception: " << e.what() << std::endl;
+                }
+            } catch (...) {
+                if (m_debug) {
+                    std::cerr << "Warning: typed event handler threw exception" << std::endl;
+                }
+            }
+            ++typed_handlers_itr;
+        }
+
+        if (subscription_handlers_itr == subscription_handlers_end) {
+            return;
+        }
+
+        // All handlers of this EVENT share the zone, which lets them keep (copies of)
+        // the event beyond returning from the handler.
+        wamp_event event(zone);
+        if (payload) {
+            event.set_lazy_payload(payload);
+        }
+        if (message.size() > 4) {
+            event.set_arguments(message[4]);
+
+            if (message.size() > 5) {
                 event.set_kw_arguments(message[5]);
             }
         }
@@ -984,7 +1955,11 @@ void wamp_session<IStream, OStream>::process_registered(const wamp_message& mess
         }
 
         uint64_t registration_id = message[2].as<uint64_t>();
-        m_procedures[registration_id] = register_request_itr->second->procedure();
+        if (register_request_itr->second->typed_procedure()) {
+            m_typed_procedures[registration_id] = register_request_itr->second->typed_procedure();
+        } else {
+            m_procedures[registration_id] = register_request_itr->second->procedure();
+        }
         register_request_itr->second->set_response(wamp_registration(registration_id));
     } else {
         throw protocol_error("REGISTERED - no pending request ID");
@@ -1015,10 +1990,10 @@ void wamp_session<IStream, OStream>::got_message_header(const boost::system::err
         }
 
         // read actual message
-        m_unpacker.reserve_buffer(m_message_length);
+        m_message_buffer.resize(m_message_length);
 
         boost::asio::async_read(m_in,
-            boost::asio::buffer(m_unpacker.buffer(), m_message_length),
+            boost::asio::buffer(m_message_buffer.data(), m_message_length),
             bind(&wamp_session<IStream, OStream>::got_message_body, this->shared_from_this(), boost::asio::placeholders::error));
     } else {
         handleRxError(error);
@@ -1033,17 +2008,32 @@ void wamp_session<IStream, OStream>::got_message_body(const boost::system::error
             std::cerr << "RX message received." << std::endl;
         }
 
-        m_unpacker.buffer_consumed(m_message_length);
-        msgpack::unpacked result;
+        // Strings and binaries are copied into the zone rather than referenced, since
+        // the receive buffer is reused for the next message while the zone may live on
+        // in a result, event or invocation.
+        auto copy_all = [](msgpack::type::object_type, std::size_t, void*) { return false; };
+
+        std::size_t offset = 0;
+        while (offset < m_message_length) {
+            // Malformed messages are rejected before any memory is spent on them.
+            const std::size_t end = detail::validate_wamp_message(
+                    m_message_buffer.data(), m_message_length, offset);
 
-        while (m_unpacker.next(&result)) {
-            msgpack::object obj(result.get());
+            auto zone = m_zone_pool.acquire(end - offset);
+            std::shared_ptr<wamp_lazy_payload> payload;
+            msgpack::object obj = m_lazy_payloads
+                    ? unpack_envelope(zone, offset, end, payload)
+                    : msgpack::unpack(*zone, m_message_buffer.data(), end, offset, copy_all);
 
             if (m_debug) {
                 std::cerr << "RX WAMP message: " << obj << std::endl;
             }
 
-            got_message(obj, std::move(result.zone()));
+            got_message(obj, zone, payload);
+        }
+
+        if (m_message_buffer.capacity() > m_receive_buffer_limit) {
+            std::vector<char>().swap(m_message_buffer);
         }
 
         if (!m_stopped) {
@@ -1054,10 +2044,89 @@ void wamp_session<IStream, OStream>::got_message_body(const boost::system::error
     }
 }
 
+template<typename IStream, typename OStream>
+msgpack::object wamp_session<IStream, OStream>::unpack_envelope(
+        const std::shared_ptr<msgpack::zone>& zone,
+        std::size_t& offset,
+        std::size_t end,
+        std::shared_ptr<wamp_lazy_payload>& payload)
+{
+    auto copy_all = [](msgpack::type::object_type, std::size_t, void*) { return false; };
+
+    const char* data = m_message_buffer.data();
+    const std::size_t begin = offset;
+    wamp_msgpack_cursor message(wamp_msgpack_span(data + begin, end - begin));
+
+    // Position of the arguments in the messages whose payload is kept encoded.
+    std::size_t arguments_index = 0;
+    if (message.type() == msgpack::type::ARRAY && message.size() > 0) {
+        wamp_msgpack_span code_span = message.element(0);
+        std::size_t code_offset = 0;
+        msgpack::object code = msgpack::unpack(*zone, code_span.data(), code_span.size(), code_offset);
+
+        if (code.type == msgpack::type::POSITIVE_INTEGER) {
+            switch (static_cast<message_type>(code.as<int>())) {
+                case message_type::EVENT:
+                case message_type::INVOCATION:
+                    arguments_index = 4;
+                    break;
+                case message_type::RESULT:
+                    arguments_index = 3;
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    // Everything else is unpacked as a whole.
+    if (arguments_index == 0 || message.size() <= arguments_index) {
+        return msgpack::unpack(*zone, data, end, offset, copy_all);
+    }
+
+    // The number and types of the payload elements were checked by validate_wamp_message().
+    wamp_msgpack_span arguments = message.element(arguments_index);
+    wamp_msgpack_span kw_arguments;
+    if (message.size() > arguments_index + 1) {
+        kw_arguments = message.element(arguments_index + 1);
+    }
+
+    // The receive buffer is reused for the next message, so the encoded payload
+    // moves into the zone, which the payload keeps alive.
+    const std::size_t payload_size = (data + end) - arguments.data();
+    char* payload_data = static_cast<char*>(zone->allocate_no_align(payload_size));
+    memcpy(payload_data, arguments.data(), payload_size);
+
+    payload = std::make_shared<wamp_lazy_payload>(
+            zone,
+            wamp_msgpack_span(payload_data, arguments.size()),
+            kw_arguments.empty()
+                ? wamp_msgpack_span()
+                : wamp_msgpack_span(payload_data + arguments.size(), kw_arguments.size()));
+
+    // The envelope is the message without its payload.
+    msgpack::object envelope;
+    envelope.type = msgpack::type::ARRAY;
+    envelope.via.array.size = static_cast<uint32_t>(arguments_index);
+    envelope.via.array.ptr = static_cast<msgpack::object*>(
+            zone->allocate_align(sizeof(msgpack::object) * arguments_index));
+
+    for (std::size_t i = 0; i < arguments_index; ++i) {
+        wamp_msgpack_span element = message.element(i);
+        std::size_t element_offset = 0;
+        envelope.via.array.ptr[i] = msgpack::unpack(
+                *zone, element.data(), element.size(), element_offset, copy_all);
+    }
+
+    offset = end;
+    return envelope;
+}
 
 template<typename IStream, typename OStream>
 void wamp_session<IStream, OStream>::got_message(
-        const msgpack::object& obj, msgpack::unique_ptr<msgpack::zone>&& zone)
+        const msgpack::object& obj,
+        const std::shared_ptr<msgpack::zone>& zone,
+        const std::shared_ptr<wamp_lazy_payload>& payload)
 {
 
     if (obj.type != msgpack::type::ARRAY) {
@@ -1102,7 +2171,7 @@ void wamp_session<IStream, OStream>::got_message(
         case message_type::PUBLISH:
             throw protocol_error("received PUBLISH message unexpected for WAMP client roles");
         case message_type::PUBLISHED:
-            // FIXME
+            process_published(message);
             break;
         case message_type::SUBSCRIBE:
             throw protocol_error("received SUBSCRIBE message unexpected for WAMP client roles");
@@ -1115,14 +2184,14 @@ void wamp_session<IStream, OStream>::got_message(
             process_unsubscribed(message);
             break;
         case message_type::EVENT:
-            process_event(message);
+            process_event(message, zone, payload);
             break;
         case message_type::CALL:
             throw protocol_error("received CALL message unexpected for WAMP client roles");
         case message_type::CANCEL:
             throw protocol_error("received CANCEL message unexpected for WAMP client roles");
         case message_type::RESULT:
-            process_call_result(message, std::move(zone));
+            process_call_result(message, zone, payload);
             break;
         case message_type::REGISTER:
             throw protocol_error("received REGISTER message unexpected for WAMP client roles");
@@ -1135,7 +2204,7 @@ void wamp_session<IStream, OStream>::got_message(
             // FIXME
             break;
         case message_type::INVOCATION:
-            process_invocation(message, std::move(zone));
+            process_invocation(message, zone, payload);
             break;
         case message_type::INTERRUPT:
             throw protocol_error("received INTERRUPT message - not implemented");
@@ -1182,4 +2251,28 @@ void wamp_session<IStream, OStream>::send(const std::shared_ptr<msgpack::sbuffer
     }
 }
 
+template<typename IStream, typename OStream>
+void wamp_session<IStream, OStream>::send_frames(const std::shared_ptr<msgpack::sbuffer>& frames)
+{
+    try {
+        if (!m_stopped) {
+            if (m_debug) {
+                std::cerr << "TX frames (" << frames->size() << " octets) ..." << std::endl;
+            }
+
+            std::size_t written = boost::asio::write(m_out, boost::asio::buffer(frames->data(), frames->size()));
+
+            if (m_debug) {
+                std::cerr << "TX frames sent (" << written << " / " << frames->size() << " octets)" << std::endl;
+            }
+        } else {
+            if (m_debug) {
+                std::cerr << "TX frames skipped since session stopped (" << frames->size() << " octets)." << std::endl;
+            }
+        }
+    } catch (...) {
+        std::cerr << "send error" << std::endl;
+    }
+}
+
 } // namespace autobahn
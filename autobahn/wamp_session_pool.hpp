@@ -0,0 +1,206 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_SESSION_POOL_HPP
+#define AUTOBAHN_WAMP_SESSION_POOL_HPP
+
+#include "wamp_call_result.hpp"
+#include "wamp_runtime.hpp"
+#include "wamp_session.hpp"
+#include "wamp_tcp_client.hpp"
+
+// http://stackoverflow.com/questions/22597948/using-boostfuture-with-then-continuations/
+#define BOOST_THREAD_PROVIDES_FUTURE
+#define BOOST_THREAD_PROVIDES_FUTURE_CONTINUATION
+#define BOOST_THREAD_PROVIDES_FUTURE_WHEN_ALL_WHEN_ANY
+#include <boost/asio.hpp>
+#include <boost/thread/future.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace autobahn {
+
+/// How a wamp_session_pool picks the member session for a call.
+enum class wamp_pool_balancing
+{
+    /// Rotate over the healthy members.
+    round_robin,
+
+    /// Pick the healthy member with the fewest unanswered calls.
+    least_outstanding
+};
+
+/*!
+ * A fixed set of WAMP sessions joined to the same realm that spreads calls and
+ * publications over its members.
+ *
+ * Calls are balanced according to the pool's wamp_pool_balancing. Publications
+ * to one topic always go out on the same member while that member is healthy,
+ * so events published through the pool keep their per-topic order.
+ *
+ * A member is taken out of rotation when it fails to connect or disconnects.
+ * Calls in flight on a member that disconnects fail with an
+ * autobahn::no_session_error before the member is marked down, so they can be
+ * retried on the pool. Work already issued on the remaining
+ * members is not affected.
+ */
+class wamp_session_pool
+{
+public:
+    /*!
+     * Create a pool whose members all run on one io_service.
+     *
+     * \param io The io_service to run the member sessions on.
+     * \param endpoint The rawsocket endpoint of the WAMP router.
+     * \param realm The realm every member joins.
+     * \param size The number of member sessions.
+     * \param balancing How calls are spread over the members.
+     * \param debug Enable debug output of the member sessions.
+     */
+    wamp_session_pool(
+            std::shared_ptr<boost::asio::io_service> io,
+            const boost::asio::ip::tcp::endpoint& endpoint,
+            const std::string& realm,
+            std::size_t size,
+            wamp_pool_balancing balancing = wamp_pool_balancing::least_outstanding,
+            bool debug = false);
+
+    /*!
+     * Create a pool whose members are distributed over the reactors of a runtime.
+     *
+     * \param runtime The runtime whose reactors the member sessions run on.
+     * \param endpoint The rawsocket endpoint of the WAMP router.
+     * \param realm The realm every member joins.
+     * \param size The number of member sessions.
+     * \param balancing How calls are spread over the members.
+     * \param debug Enable debug output of the member sessions.
+     */
+    wamp_session_pool(
+            wamp_runtime& runtime,
+            const boost::asio::ip::tcp::endpoint& endpoint,
+            const std::string& realm,
+            std::size_t size,
+            wamp_pool_balancing balancing = wamp_pool_balancing::least_outstanding,
+            bool debug = false);
+
+    wamp_session_pool(const wamp_session_pool&) = delete;
+    wamp_session_pool& operator=(const wamp_session_pool&) = delete;
+
+    /*!
+     * Connect all members and join them to the realm.
+     *
+     * \return A future that resolves with the number of members that joined
+     *         once every member has either joined or failed to connect.
+     */
+    boost::future<std::size_t> launch();
+
+    /*!
+     * The number of member sessions, healthy or not.
+     */
+    std::size_t size() const;
+
+    /*!
+     * The number of members currently taking work.
+     */
+    std::size_t healthy() const;
+
+    /*!
+     * Publish an event with empty payload to a topic.
+     *
+     * @throw no_session_error if no member is healthy.
+     */
+    void publish(const std::string& topic);
+
+    /*!
+     * Publish an event with positional payload to a topic.
+     *
+     * @throw no_session_error if no member is healthy.
+     */
+    template <typename List>
+    void publish(const std::string& topic, const List& arguments);
+
+    /*!
+     * Publish an event with both positional and keyword payload to a topic.
+     *
+     * @throw no_session_error if no member is healthy.
+     */
+    template <typename List, typename Map>
+    void publish(const std::string& topic, const List& arguments, const Map& kw_arguments);
+
+    /*!
+     * Calls a remote procedure with no arguments on one of the members.
+     *
+     * @throw no_session_error if no member is healthy.
+     */
+    boost::future<wamp_call_result> call(const std::string& procedure);
+
+    /*!
+     * Calls a remote procedure with positional arguments on one of the members.
+     *
+     * @throw no_session_error if no member is healthy.
+     */
+    template <typename List>
+    boost::future<wamp_call_result> call(
+            const std::string& procedure, const List& arguments);
+
+    /*!
+     * Calls a remote procedure with positional and keyword arguments on one of the members.
+     *
+     * @throw no_session_error if no member is healthy.
+     */
+    template <typename List, typename Map>
+    boost::future<wamp_call_result> call(
+            const std::string& procedure, const List& arguments, const Map& kw_arguments);
+
+private:
+    /// A member session of the pool.
+    struct member
+    {
+        std::shared_ptr<wamp_tcp_client> client;
+        std::atomic<bool> healthy;
+    };
+
+    /// Create the member structure around a client and watch it for disconnects.
+    void add_member(const std::shared_ptr<wamp_tcp_client>& client);
+
+    /// The member the next call is issued on.
+    member& select_for_call();
+
+    /// The member events for @p topic are published on.
+    member& select_for_topic(const std::string& topic);
+
+    wamp_pool_balancing m_balancing;
+
+    /// Members in creation order; the set never changes after construction.
+    std::vector<std::shared_ptr<member>> m_members;
+
+    /// Round robin position of the next call.
+    std::atomic<std::size_t> m_next_member;
+
+    /// Keeps the launch continuations alive until they ran.
+    std::vector<boost::future<void>> m_launches;
+};
+
+} // namespace autobahn
+
+#include "wamp_session_pool.ipp"
+
+#endif // AUTOBAHN_WAMP_SESSION_POOL_HPP
@@ -0,0 +1,218 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "exceptions.hpp"
+
+#include <functional>
+#include <limits>
+
+namespace autobahn {
+
+inline wamp_session_pool::wamp_session_pool(
+        std::shared_ptr<boost::asio::io_service> io,
+        const boost::asio::ip::tcp::endpoint& endpoint,
+        const std::string& realm,
+        std::size_t size,
+        wamp_pool_balancing balancing,
+        bool debug)
+    : m_balancing(balancing)
+    , m_members()
+    , m_next_member(ATOMIC_VAR_INIT(0))
+    , m_launches()
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        add_member(std::make_shared<wamp_tcp_client>(io, endpoint, realm, debug));
+    }
+}
+
+inline wamp_session_pool::wamp_session_pool(
+        wamp_runtime& runtime,
+        const boost::asio::ip::tcp::endpoint& endpoint,
+        const std::string& realm,
+        std::size_t size,
+        wamp_pool_balancing balancing,
+        bool debug)
+    : m_balancing(balancing)
+    , m_members()
+    , m_next_member(ATOMIC_VAR_INIT(0))
+    , m_launches()
+{
+    for (std::size_t i = 0; i < size; ++i) {
+        add_member(runtime.create_client(endpoint, realm, debug));
+    }
+}
+
+inline void wamp_session_pool::add_member(const std::shared_ptr<wamp_tcp_client>& client)
+{
+    auto new_member = std::make_shared<member>();
+    new_member->client = client;
+    new_member->healthy = false;
+
+    std::weak_ptr<member> weak_member = new_member;
+    client->m_onDisconnect.connect([weak_member]() {
+        auto shared_member = weak_member.lock();
+        if (shared_member) {
+            shared_member->healthy = false;
+        }
+    });
+
+    m_members.push_back(new_member);
+}
+
+inline boost::future<std::size_t> wamp_session_pool::launch()
+{
+    auto joined = std::make_shared<std::atomic<std::size_t>>(0);
+    auto remaining = std::make_shared<std::atomic<std::size_t>>(m_members.size());
+    auto launched = std::make_shared<boost::promise<std::size_t>>();
+
+    if (m_members.empty()) {
+        launched->set_value(0);
+    }
+
+    for (const auto& launching_member : m_members) {
+        m_launches.push_back(launching_member->client->launch().then(
+                [launching_member, joined, remaining, launched](boost::future<bool> connected) {
+            bool success = false;
+            try {
+                success = connected.get();
+            } catch (...) {
+            }
+
+            launching_member->healthy = success;
+            if (success) {
+                ++*joined;
+            }
+
+            if (--*remaining == 0) {
+                launched->set_value(*joined);
+            }
+        }));
+    }
+
+    return launched->get_future();
+}
+
+inline std::size_t wamp_session_pool::size() const
+{
+    return m_members.size();
+}
+
+inline std::size_t wamp_session_pool::healthy() const
+{
+    std::size_t count = 0;
+    for (const auto& candidate : m_members) {
+        if (candidate->healthy) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+inline wamp_session_pool::member& wamp_session_pool::select_for_call()
+{
+    const std::size_t size = m_members.size();
+
+    if (m_balancing == wamp_pool_balancing::round_robin) {
+        for (std::size_t i = 0; i < size; ++i) {
+            member& candidate = *m_members[m_next_member++ % size];
+            if (candidate.healthy) {
+                return candidate;
+            }
+        }
+    } else {
+        member* selected = nullptr;
+        std::size_t selected_load = std::numeric_limits<std::size_t>::max();
+
+        // Start at a rotating offset so that ties do not always go to the first member.
+        std::size_t offset = m_next_member++;
+        for (std::size_t i = 0; i < size; ++i) {
+            member& candidate = *m_members[(offset + i) % size];
+            if (!candidate.healthy) {
+                continue;
+            }
+
+            std::size_t load = (*candidate.client)->outstanding_calls();
+            if (load < selected_load) {
+                selected = &candidate;
+                selected_load = load;
+            }
+        }
+
+        if (selected) {
+            return *selected;
+        }
+    }
+
+    throw no_session_error();
+}
+
+inline wamp_session_pool::member& wamp_session_pool::select_for_topic(const std::string& topic)
+{
+    const std::size_t size = m_members.size();
+
+    // Walk the ring from the topic's home member so that a topic only moves
+    // when its home member drops out.
+    std::size_t home = std::hash<std::string>()(topic);
+    for (std::size_t i = 0; i < size; ++i) {
+        member& candidate = *m_members[(home + i) % size];
+        if (candidate.healthy) {
+            return candidate;
+        }
+    }
+
+    throw no_session_error();
+}
+
+inline void wamp_session_pool::publish(const std::string& topic)
+{
+    (*select_for_topic(topic).client)->publish(topic);
+}
+
+template <typename List>
+inline void wamp_session_pool::publish(const std::string& topic, const List& arguments)
+{
+    (*select_for_topic(topic).client)->publish(topic, arguments);
+}
+
+template <typename List, typename Map>
+inline void wamp_session_pool::publish(
+        const std::string& topic, const List& arguments, const Map& kw_arguments)
+{
+    (*select_for_topic(topic).client)->publish(topic, arguments, kw_arguments);
+}
+
+inline boost::future<wamp_call_result> wamp_session_pool::call(const std::string& procedure)
+{
+    return (*select_for_call().client)->call(procedure);
+}
+
+template <typename List>
+inline boost::future<wamp_call_result> wamp_session_pool::call(
+        const std::string& procedure, const List& arguments)
+{
+    return (*select_for_call().client)->call(procedure, arguments);
+}
+
+template <typename List, typename Map>
+inline boost::future<wamp_call_result> wamp_session_pool::call(
+        const std::string& procedure, const List& arguments, const Map& kw_arguments)
+{
+    return (*select_for_call().client)->call(procedure, arguments, kw_arguments);
+}
+
+} // namespace autobahn
@@ -0,0 +1,84 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_SUBSCRIBE_OPTIONS_HPP
+#define AUTOBAHN_WAMP_SUBSCRIBE_OPTIONS_HPP
+
+#include <boost/asio.hpp>
+#include <cstddef>
+#include <memory>
+
+namespace autobahn {
+
+/// What a queued subscription does with an event that arrives while its queue is full.
+enum class wamp_overflow_policy
+{
+    /// Discard the arriving event.
+    drop_newest,
+
+    /// Discard the oldest queued event to make room for the arriving one.
+    drop_oldest,
+
+    /// Stall the session's io thread until the queue has room. Never use this
+    /// when the executor is run by the session's own io thread.
+    block
+};
+
+/// Local options for how a subscription's events are delivered to its handler.
+class wamp_subscribe_options
+{
+public:
+    wamp_subscribe_options();
+
+    /*!
+     * The executor that runs the handler, or null to run it inline on the
+     * session's io thread (the default).
+     */
+    const std::shared_ptr<boost::asio::io_service>& executor() const;
+
+    /*!
+     * The maximum number of events queued for the handler.
+     */
+    std::size_t max_queue_depth() const;
+
+    /*!
+     * What to do with events that arrive while the queue is full.
+     */
+    wamp_overflow_policy overflow_policy() const;
+
+    /*!
+     * Run the handler on @p executor. Events of the subscription are still
+     * delivered one at a time and in order, however many threads run the executor.
+     */
+    void set_executor(const std::shared_ptr<boost::asio::io_service>& executor);
+
+    void set_max_queue_depth(std::size_t max_queue_depth);
+
+    void set_overflow_policy(wamp_overflow_policy overflow_policy);
+
+private:
+    std::shared_ptr<boost::asio::io_service> m_executor;
+    std::size_t m_max_queue_depth;
+    wamp_overflow_policy m_overflow_policy;
+};
+
+} // namespace autobahn
+
+#include "wamp_subscribe_options.ipp"
+
+#endif // AUTOBAHN_WAMP_SUBSCRIBE_OPTIONS_HPP
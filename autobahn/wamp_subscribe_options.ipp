@@ -0,0 +1,58 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_subscribe_options::wamp_subscribe_options()
+    : m_executor()
+    , m_max_queue_depth(1024)
+    , m_overflow_policy(wamp_overflow_policy::drop_oldest)
+{
+}
+
+inline const std::shared_ptr<boost::asio::io_service>& wamp_subscribe_options::executor() const
+{
+    return m_executor;
+}
+
+inline std::size_t wamp_subscribe_options::max_queue_depth() const
+{
+    return m_max_queue_depth;
+}
+
+inline wamp_overflow_policy wamp_subscribe_options::overflow_policy() const
+{
+    return m_overflow_policy;
+}
+
+inline void wamp_subscribe_options::set_executor(const std::shared_ptr<boost::asio::io_service>& executor)
+{
+    m_executor = executor;
+}
+
+inline void wamp_subscribe_options::set_max_queue_depth(std::size_t max_queue_depth)
+{
+    m_max_queue_depth = max_queue_depth;
+}
+
+inline void wamp_subscribe_options::set_overflow_policy(wamp_overflow_policy overflow_policy)
+{
+    m_overflow_policy = overflow_policy;
+}
+
+} // namespace autobahn
@@ -21,6 +21,7 @@
 
 #include "wamp_event_handler.hpp"
 #include "wamp_subscription.hpp"
+#include "wamp_typed_event_handler.hpp"
 
 // http://stackoverflow.com/questions/22597948/using-boostfuture-with-then-continuations/
 #define BOOST_THREAD_PROVIDES_FUTURE
@@ -36,14 +37,17 @@ class wamp_subscribe_request
 public:
     wamp_subscribe_request();
     wamp_subscribe_request(const wamp_event_handler& handler);
+    wamp_subscribe_request(const wamp_typed_event_handler& typed_handler);
 
     const wamp_event_handler& handler() const;
+    const wamp_typed_event_handler& typed_handler() const;
     boost::promise<wamp_subscription>& response();
     void set_handler(const wamp_event_handler& handler) const;
     void set_response(const wamp_subscription& subscription);
 
 private:
     wamp_event_handler m_handler;
+    wamp_typed_event_handler m_typed_handler;
     boost::promise<wamp_subscription> m_response;
 };
 
@@ -20,12 +20,21 @@ namespace autobahn {
 
 inline wamp_subscribe_request::wamp_subscribe_request()
     : m_handler()
+    , m_typed_handler()
     , m_response()
 {
 }
 
 inline wamp_subscribe_request::wamp_subscribe_request(const wamp_event_handler& handler)
     : m_handler(handler)
+    , m_typed_handler()
+    , m_response()
+{
+}
+
+inline wamp_subscribe_request::wamp_subscribe_request(const wamp_typed_event_handler& typed_handler)
+    : m_handler()
+    , m_typed_handler(typed_handler)
     , m_response()
 {
 }
@@ -35,6 +44,11 @@ inline const wamp_event_handler& wamp_subscribe_request::handler() const
     return m_handler;
 }
 
+inline const wamp_typed_event_handler& wamp_subscribe_request::typed_handler() const
+{
+    return m_typed_handler;
+}
+
 inline boost::promise<wamp_subscription>& wamp_subscribe_request::response()
 {
     return m_response;
@@ -78,6 +78,27 @@ public:
         return m_isConnected;
     }
 
+    /**
+     * @brief the io_service (reactor) that the socket and session of this client are bound to
+     */
+    const std::shared_ptr<boost::asio::io_service> &io_service() const {
+        return m_pIo;
+    }
+
+    /**
+     * @brief runs Fn(session) on the io_service owning this client
+     *
+     * When called from that io_service's thread Fn runs inline, so session operations
+     * issued from inside Fn are dispatched without going through the io_service queue.
+     */
+    template <typename Function>
+    void dispatch(Function Fn) {
+        std::shared_ptr<wamp_tcp_session_t> pSession = m_pSession;
+        m_pIo->dispatch([pSession, Fn]() mutable {
+            Fn(pSession);
+        });
+    }
+
     /**
      * @brief launches the session asynchronously, returns a future containing an error code (0 means success)
      */
@@ -0,0 +1,116 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_TIMING_WHEEL_HPP
+#define AUTOBAHN_WAMP_TIMING_WHEEL_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A hierarchical timing wheel of 64 bit IDs keyed by expiry tick.
+ *
+ * Four levels of 256 slots cover 2^32 ticks. Scheduling is O(1), and each entry
+ * moves down at most three times (once per level) before it expires. Entries
+ * further out than the levels cover wait in an overflow list. The wheel has no
+ * clock of its own; its owner advances it to the current tick.
+ *
+ * The slot of an entry follows from its expiry and the current tick alone, so
+ * cancelling only scans the entries that share that slot.
+ */
+class wamp_timing_wheel
+{
+public:
+    wamp_timing_wheel();
+
+    /*!
+     * The tick the wheel was last advanced to.
+     */
+    uint64_t now() const;
+
+    /*!
+     * The number of scheduled entries.
+     */
+    std::size_t size() const;
+
+    bool empty() const;
+
+    /*!
+     * The number of octets the wheel occupies, including the storage of its slots.
+     */
+    std::size_t memory_footprint() const;
+
+    /*!
+     * Schedule @p id to expire at @p expiry. Expiries that are not in the future
+     * are moved to the next tick.
+     */
+    void schedule(uint64_t id, uint64_t expiry);
+
+    /*!
+     * Remove @p id, scheduled with @p expiry, before it expires.
+     *
+     * \return Whether the entry was still scheduled.
+     */
+    bool cancel(uint64_t id, uint64_t expiry);
+
+    /*!
+     * Advance the wheel to @p tick and append the IDs that expired on the way to
+     * @p expired, in expiry order.
+     */
+    void advance(uint64_t tick, std::vector<uint64_t>& expired);
+
+private:
+    static const unsigned LEVELS = 4;
+    static const unsigned SLOT_BITS = 8;
+    static const unsigned SLOTS = 1u << SLOT_BITS;
+
+    struct entry
+    {
+        uint64_t id;
+        uint64_t expiry;
+    };
+
+    typedef std::vector<entry> slot;
+
+    /// The slot of the lowest level that can hold an entry expiring at @p expiry > now.
+    slot& slot_for(uint64_t expiry);
+
+    /// Put an entry with expiry > now into the slot for its expiry.
+    void place(const entry& scheduled);
+
+    /// Move all entries of @p entries to lower levels.
+    void cascade(slot& entries);
+
+    std::array<std::array<slot, SLOTS>, LEVELS> m_levels;
+
+    /// Entries expiring beyond the range of the top level.
+    slot m_overflow;
+
+    uint64_t m_now;
+    std::size_t m_size;
+};
+
+} // namespace autobahn
+
+#include "wamp_timing_wheel.ipp"
+
+#endif // AUTOBAHN_WAMP_TIMING_WHEEL_HPP
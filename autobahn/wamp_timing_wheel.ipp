@@ -0,0 +1,158 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <utility>
+
+namespace autobahn {
+
+inline wamp_timing_wheel::wamp_timing_wheel()
+    : m_levels()
+    , m_overflow()
+    , m_now(0)
+    , m_size(0)
+{
+}
+
+inline uint64_t wamp_timing_wheel::now() const
+{
+    return m_now;
+}
+
+inline std::size_t wamp_timing_wheel::size() const
+{
+    return m_size;
+}
+
+inline bool wamp_timing_wheel::empty() const
+{
+    return m_size == 0;
+}
+
+inline std::size_t wamp_timing_wheel::memory_footprint() const
+{
+    std::size_t footprint = sizeof(*this) + m_overflow.capacity() * sizeof(entry);
+    for (const auto& level : m_levels) {
+        for (const auto& entries : level) {
+            footprint += entries.capacity() * sizeof(entry);
+        }
+    }
+    return footprint;
+}
+
+inline void wamp_timing_wheel::schedule(uint64_t id, uint64_t expiry)
+{
+    // The slot of the current tick has already been expired.
+    if (expiry <= m_now) {
+        expiry = m_now + 1;
+    }
+
+    entry scheduled = { id, expiry };
+    place(scheduled);
+    ++m_size;
+}
+
+inline bool wamp_timing_wheel::cancel(uint64_t id, uint64_t expiry)
+{
+    // Mirror the adjustment schedule() made. An entry whose expiry has passed has
+    // already been expired and is not found.
+    if (expiry <= m_now) {
+        expiry = m_now + 1;
+    }
+
+    slot& entries = slot_for(expiry);
+    for (auto itr = entries.begin(); itr != entries.end(); ++itr) {
+        if (itr->id == id && itr->expiry == expiry) {
+            *itr = entries.back();
+            entries.pop_back();
+            --m_size;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+inline wamp_timing_wheel::slot& wamp_timing_wheel::slot_for(uint64_t expiry)
+{
+    // An entry lives on the lowest level whose slot range contains both now and
+    // the expiry, i.e. above which the two ticks do not differ. It stays there
+    // until now enters the range of its slot, which is when the slot is cascaded.
+    uint64_t difference = expiry ^ m_now;
+
+    for (unsigned level = 0; level < LEVELS; ++level) {
+        if ((difference >> (SLOT_BITS * (level + 1))) == 0) {
+            return m_levels[level][(expiry >> (SLOT_BITS * level)) & (SLOTS - 1)];
+        }
+    }
+
+    return m_overflow;
+}
+
+inline void wamp_timing_wheel::place(const entry& scheduled)
+{
+    slot_for(scheduled.expiry).push_back(scheduled);
+}
+
+inline void wamp_timing_wheel::cascade(slot& entries)
+{
+    slot moving;
+    moving.swap(entries);
+
+    for (const entry& moved : moving) {
+        place(moved);
+    }
+}
+
+inline void wamp_timing_wheel::advance(uint64_t tick, std::vector<uint64_t>& expired)
+{
+    if (m_size == 0) {
+        if (tick > m_now) {
+            m_now = tick;
+        }
+        return;
+    }
+
+    while (m_now < tick) {
+        ++m_now;
+
+        // When a level wraps, the matching slot of the level above now covers the
+        // current range and is spread out below. Higher levels go first so that
+        // their entries can still be cascaded further down in the same tick.
+        if ((m_now & ((uint64_t(1) << (SLOT_BITS * LEVELS)) - 1)) == 0) {
+            cascade(m_overflow);
+        }
+        for (unsigned level = LEVELS - 1; level > 0; --level) {
+            if ((m_now & ((uint64_t(1) << (SLOT_BITS * level)) - 1)) == 0) {
+                cascade(m_levels[level][(m_now >> (SLOT_BITS * level)) & (SLOTS - 1)]);
+            }
+        }
+
+        slot& due = m_levels[0][m_now & (SLOTS - 1)];
+        for (const entry& expiring : due) {
+            expired.push_back(expiring.id);
+        }
+        m_size -= due.size();
+        due.clear();
+
+        if (m_size == 0) {
+            m_now = tick;
+        }
+    }
+}
+
+} // namespace autobahn
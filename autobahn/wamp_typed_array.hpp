@@ -0,0 +1,219 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_TYPED_ARRAY_HPP
+#define AUTOBAHN_WAMP_TYPED_ARRAY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <msgpack.hpp>
+#include <vector>
+
+namespace autobahn {
+
+/// The element types of typed arrays.
+enum class wamp_dtype : uint8_t
+{
+    INT8 = 1,
+    UINT8 = 2,
+    INT16 = 3,
+    UINT16 = 4,
+    INT32 = 5,
+    UINT32 = 6,
+    INT64 = 7,
+    UINT64 = 8,
+    FLOAT32 = 9,
+    FLOAT64 = 10
+};
+
+/// The msgpack extension type typed arrays are encoded as.
+static const int8_t TYPED_ARRAY_EXT_TYPE = 0x10;
+
+namespace detail {
+
+/// The wamp_dtype of element type T. Only defined for the supported types.
+template <typename T>
+struct typed_array_dtype;
+
+template <> struct typed_array_dtype<int8_t> { static const wamp_dtype value = wamp_dtype::INT8; };
+template <> struct typed_array_dtype<uint8_t> { static const wamp_dtype value = wamp_dtype::UINT8; };
+template <> struct typed_array_dtype<int16_t> { static const wamp_dtype value = wamp_dtype::INT16; };
+template <> struct typed_array_dtype<uint16_t> { static const wamp_dtype value = wamp_dtype::UINT16; };
+template <> struct typed_array_dtype<int32_t> { static const wamp_dtype value = wamp_dtype::INT32; };
+template <> struct typed_array_dtype<uint32_t> { static const wamp_dtype value = wamp_dtype::UINT32; };
+template <> struct typed_array_dtype<int64_t> { static const wamp_dtype value = wamp_dtype::INT64; };
+template <> struct typed_array_dtype<uint64_t> { static const wamp_dtype value = wamp_dtype::UINT64; };
+template <> struct typed_array_dtype<float> { static const wamp_dtype value = wamp_dtype::FLOAT32; };
+template <> struct typed_array_dtype<double> { static const wamp_dtype value = wamp_dtype::FLOAT64; };
+
+/// Version of the encoding, the first octet of the extension data.
+static const uint8_t TYPED_ARRAY_VERSION = 1;
+
+/// Octets of the extension data preceding the dimensions.
+static const std::size_t TYPED_ARRAY_HEADER_SIZE = 4;
+
+void store_uint32_le(uint32_t value, char* bytes);
+uint32_t load_uint32_le(const char* bytes);
+
+template <typename T>
+T load_le(const char* bytes);
+
+} // namespace detail
+
+/*!
+ * A contiguous array of numbers to pass as a single argument, encoded in bulk
+ * instead of as one msgpack element per number.
+ *
+ * The array is packed as a msgpack extension of type TYPED_ARRAY_EXT_TYPE
+ * holding a version octet, the wamp_dtype, the number of dimensions and a
+ * reserved octet, then each dimension as a 32-bit unsigned integer and then
+ * the elements, all in little endian byte order. On little endian hosts the
+ * elements are written with a single copy.
+ *
+ * The array refers to the elements it is constructed with, which must stay
+ * alive until it is packed.
+ *
+ * Example:
+ * ```
+ * std::vector<float> samples = read_samples();
+ * session->publish("com.example.telemetry",
+ *         std::make_tuple(autobahn::wamp_typed_array<float>(samples)));
+ * ```
+ *
+ * The receiving side reads the array with wamp_event::typed_array_argument().
+ */
+template <typename T>
+class wamp_typed_array
+{
+public:
+    /*!
+     * A one-dimensional array of @p size elements.
+     */
+    wamp_typed_array(const T* data, std::size_t size);
+
+    /*!
+     * An array of the given @p shape, its elements in row-major order.
+     *
+     * @throw std::invalid_argument if @p shape has more than 255 dimensions
+     */
+    wamp_typed_array(const T* data, const std::vector<uint32_t>& shape);
+
+    explicit wamp_typed_array(const std::vector<T>& values);
+
+    const T* data() const;
+
+    /// The number of elements.
+    std::size_t size() const;
+
+    const std::vector<uint32_t>& shape() const;
+
+private:
+    const T* m_data;
+    std::size_t m_size;
+    std::vector<uint32_t> m_shape;
+};
+
+/*!
+ * A received typed array (see wamp_typed_array), read in place from the
+ * payload it was converted from.
+ *
+ * The elements are not necessarily aligned within the payload, so they are
+ * returned by value rather than by reference. A view is only valid as long as
+ * the event or call result it was taken from is alive.
+ */
+template <typename T>
+class wamp_typed_array_view
+{
+public:
+    wamp_typed_array_view();
+
+    /*!
+     * A view of @p size elements at @p data with @p rank dimensions at
+     * @p dimensions, all encoded in little endian byte order.
+     */
+    wamp_typed_array_view(const char* dimensions, std::size_t rank, const char* data, std::size_t size);
+
+    /// The number of elements.
+    std::size_t size() const;
+    bool empty() const;
+
+    /// The number of dimensions.
+    std::size_t rank() const;
+
+    /*!
+     * The extent of the dimension with the given @p index.
+     *
+     * @throw std::out_of_range
+     */
+    uint32_t dimension(std::size_t index) const;
+
+    /*!
+     * The element at @p index in row-major order. Not bounds checked.
+     */
+    T operator[](std::size_t index) const;
+
+    /*!
+     * The encoded elements, size() * sizeof(T) octets in little endian byte order.
+     */
+    const char* bytes() const;
+
+    /*!
+     * Copy the elements to @p destination, which must have room for size() elements.
+     */
+    void copy_to(T* destination) const;
+
+    std::vector<T> to_vector() const;
+
+private:
+    const char* m_dimensions;
+    std::size_t m_rank;
+    const char* m_data;
+    std::size_t m_size;
+};
+
+} // namespace autobahn
+
+namespace msgpack {
+MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) {
+namespace adaptor {
+
+template <typename T>
+struct pack<autobahn::wamp_typed_array<T>>
+{
+    template <typename Stream>
+    msgpack::packer<Stream>& operator()(
+            msgpack::packer<Stream>& packer, const autobahn::wamp_typed_array<T>& array) const;
+};
+
+template <typename T>
+struct convert<autobahn::wamp_typed_array_view<T>>
+{
+    /*!
+     * @throw msgpack::type_error if @p object is not a typed array of T
+     */
+    const msgpack::object& operator()(
+            const msgpack::object& object, autobahn::wamp_typed_array_view<T>& view) const;
+};
+
+} // namespace adaptor
+} // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
+} // namespace msgpack
+
+#include "wamp_typed_array.ipp"
+
+#endif // AUTOBAHN_WAMP_TYPED_ARRAY_HPP
@@ -0,0 +1,282 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include <algorithm>
+#include <boost/predef/other/endian.h>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace autobahn {
+
+namespace detail {
+
+inline void store_uint32_le(uint32_t value, char* bytes)
+{
+    bytes[0] = static_cast<char>(value & 0xff);
+    bytes[1] = static_cast<char>((value >> 8) & 0xff);
+    bytes[2] = static_cast<char>((value >> 16) & 0xff);
+    bytes[3] = static_cast<char>((value >> 24) & 0xff);
+}
+
+inline uint32_t load_uint32_le(const char* bytes)
+{
+    return static_cast<uint32_t>(static_cast<unsigned char>(bytes[0]))
+            | static_cast<uint32_t>(static_cast<unsigned char>(bytes[1])) << 8
+            | static_cast<uint32_t>(static_cast<unsigned char>(bytes[2])) << 16
+            | static_cast<uint32_t>(static_cast<unsigned char>(bytes[3])) << 24;
+}
+
+template <typename T>
+inline T load_le(const char* bytes)
+{
+    T value;
+#if BOOST_ENDIAN_LITTLE_BYTE
+    std::memcpy(&value, bytes, sizeof(T));
+#else
+    char swapped[sizeof(T)];
+    std::reverse_copy(bytes, bytes + sizeof(T), swapped);
+    std::memcpy(&value, swapped, sizeof(T));
+#endif
+    return value;
+}
+
+} // namespace detail
+
+template <typename T>
+inline wamp_typed_array<T>::wamp_typed_array(const T* data, std::size_t size)
+    : m_data(data)
+    , m_size(size)
+    , m_shape(1, static_cast<uint32_t>(size))
+{
+}
+
+template <typename T>
+inline wamp_typed_array<T>::wamp_typed_array(const T* data, const std::vector<uint32_t>& shape)
+    : m_data(data)
+    , m_size(1)
+    , m_shape(shape)
+{
+    if (shape.size() > 255) {
+        throw std::invalid_argument("typed arrays have at most 255 dimensions");
+    }
+    for (uint32_t dimension : shape) {
+        m_size *= dimension;
+    }
+}
+
+template <typename T>
+inline wamp_typed_array<T>::wamp_typed_array(const std::vector<T>& values)
+    : wamp_typed_array(values.data(), values.size())
+{
+}
+
+template <typename T>
+inline const T* wamp_typed_array<T>::data() const
+{
+    return m_data;
+}
+
+template <typename T>
+inline std::size_t wamp_typed_array<T>::size() const
+{
+    return m_size;
+}
+
+template <typename T>
+inline const std::vector<uint32_t>& wamp_typed_array<T>::shape() const
+{
+    return m_shape;
+}
+
+template <typename T>
+inline wamp_typed_array_view<T>::wamp_typed_array_view()
+    : m_dimensions(nullptr)
+    , m_rank(0)
+    , m_data(nullptr)
+    , m_size(0)
+{
+}
+
+template <typename T>
+inline wamp_typed_array_view<T>::wamp_typed_array_view(
+        const char* dimensions, std::size_t rank, const char* data, std::size_t size)
+    : m_dimensions(dimensions)
+    , m_rank(rank)
+    , m_data(data)
+    , m_size(size)
+{
+}
+
+template <typename T>
+inline std::size_t wamp_typed_array_view<T>::size() const
+{
+    return m_size;
+}
+
+template <typename T>
+inline bool wamp_typed_array_view<T>::empty() const
+{
+    return m_size == 0;
+}
+
+template <typename T>
+inline std::size_t wamp_typed_array_view<T>::rank() const
+{
+    return m_rank;
+}
+
+template <typename T>
+inline uint32_t wamp_typed_array_view<T>::dimension(std::size_t index) const
+{
+    if (index >= m_rank) {
+        throw std::out_of_range("no dimension at index " + std::to_string(index));
+    }
+    return detail::load_uint32_le(m_dimensions + 4 * index);
+}
+
+template <typename T>
+inline T wamp_typed_array_view<T>::operator[](std::size_t index) const
+{
+    return detail::load_le<T>(m_data + index * sizeof(T));
+}
+
+template <typename T>
+inline const char* wamp_typed_array_view<T>::bytes() const
+{
+    return m_data;
+}
+
+template <typename T>
+inline void wamp_typed_array_view<T>::copy_to(T* destination) const
+{
+#if BOOST_ENDIAN_LITTLE_BYTE
+    if (m_size) {
+        std::memcpy(destination, m_data, m_size * sizeof(T));
+    }
+#else
+    for (std::size_t i = 0; i < m_size; ++i) {
+        destination[i] = (*this)[i];
+    }
+#endif
+}
+
+template <typename T>
+inline std::vector<T> wamp_typed_array_view<T>::to_vector() const
+{
+    std::vector<T> values(m_size);
+    copy_to(values.data());
+    return values;
+}
+
+} // namespace autobahn
+
+namespace msgpack {
+MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS) {
+namespace adaptor {
+
+template <typename T>
+template <typename Stream>
+msgpack::packer<Stream>& pack<autobahn::wamp_typed_array<T>>::operator()(
+        msgpack::packer<Stream>& packer, const autobahn::wamp_typed_array<T>& array) const
+{
+    const std::vector<uint32_t>& shape = array.shape();
+    std::size_t header_size = autobahn::detail::TYPED_ARRAY_HEADER_SIZE + 4 * shape.size();
+    std::size_t data_size = array.size() * sizeof(T);
+    if (data_size > 0xffffffff - header_size) {
+        throw std::length_error("typed array too large for a msgpack extension");
+    }
+
+    packer.pack_ext(header_size + data_size, autobahn::TYPED_ARRAY_EXT_TYPE);
+
+    char header[autobahn::detail::TYPED_ARRAY_HEADER_SIZE] = {
+        static_cast<char>(autobahn::detail::TYPED_ARRAY_VERSION),
+        static_cast<char>(autobahn::detail::typed_array_dtype<T>::value),
+        static_cast<char>(shape.size()),
+        0
+    };
+    packer.pack_ext_body(header, sizeof(header));
+
+    for (uint32_t dimension : shape) {
+        char bytes[4];
+        autobahn::detail::store_uint32_le(dimension, bytes);
+        packer.pack_ext_body(bytes, sizeof(bytes));
+    }
+
+#if BOOST_ENDIAN_LITTLE_BYTE
+    // The elements are already in wire order and go out with one copy.
+    if (data_size) {
+        packer.pack_ext_body(reinterpret_cast<const char*>(array.data()), static_cast<uint32_t>(data_size));
+    }
+#else
+    char chunk[4096];
+    std::size_t chunk_elements = sizeof(chunk) / sizeof(T);
+    for (std::size_t first = 0; first < array.size(); first += chunk_elements) {
+        std::size_t count = std::min(chunk_elements, array.size() - first);
+        for (std::size_t i = 0; i < count; ++i) {
+            const char* element = reinterpret_cast<const char*>(array.data() + first + i);
+            std::reverse_copy(element, element + sizeof(T), chunk + i * sizeof(T));
+        }
+        packer.pack_ext_body(chunk, static_cast<uint32_t>(count * sizeof(T)));
+    }
+#endif
+
+    return packer;
+}
+
+template <typename T>
+const msgpack::object& convert<autobahn::wamp_typed_array_view<T>>::operator()(
+        const msgpack::object& object, autobahn::wamp_typed_array_view<T>& view) const
+{
+    if (object.type != msgpack::type::EXT || object.via.ext.type() != autobahn::TYPED_ARRAY_EXT_TYPE) {
+        throw msgpack::type_error();
+    }
+
+    const char* data = object.via.ext.data();
+    std::size_t size = object.via.ext.size;
+    if (size < autobahn::detail::TYPED_ARRAY_HEADER_SIZE
+            || static_cast<uint8_t>(data[0]) != autobahn::detail::TYPED_ARRAY_VERSION
+            || static_cast<uint8_t>(data[1]) != static_cast<uint8_t>(autobahn::detail::typed_array_dtype<T>::value))
+    {
+        throw msgpack::type_error();
+    }
+
+    std::size_t rank = static_cast<uint8_t>(data[2]);
+    std::size_t header_size = autobahn::detail::TYPED_ARRAY_HEADER_SIZE + 4 * rank;
+    if (size < header_size) {
+        throw msgpack::type_error();
+    }
+
+    // Counting in 64 bits cannot overflow before the count exceeds the data present.
+    const char* dimensions = data + autobahn::detail::TYPED_ARRAY_HEADER_SIZE;
+    uint64_t elements = 1;
+    for (std::size_t i = 0; i < rank && elements <= size; ++i) {
+        elements *= autobahn::detail::load_uint32_le(dimensions + 4 * i);
+    }
+    if (elements > size || elements * sizeof(T) != size - header_size) {
+        throw msgpack::type_error();
+    }
+
+    view = autobahn::wamp_typed_array_view<T>(
+            dimensions, rank, data + header_size, static_cast<std::size_t>(elements));
+    return object;
+}
+
+} // namespace adaptor
+} // MSGPACK_API_VERSION_NAMESPACE(MSGPACK_DEFAULT_API_NS)
+} // namespace msgpack
@@ -0,0 +1,51 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_TYPED_EVENT_HANDLER_HPP
+#define AUTOBAHN_WAMP_TYPED_EVENT_HANDLER_HPP
+
+#include <functional>
+#include <msgpack.hpp>
+
+namespace autobahn {
+
+/*!
+ * Handler type for subscriptions with a typed signature, see
+ * wamp_session::subscribe. It receives the positional payload of an EVENT.
+ */
+typedef std::function<void(const msgpack::object& arguments)> wamp_typed_event_handler;
+
+/*!
+ * Wrap @p handler, callable with parameters of the types @p Args, into a
+ * wamp_typed_event_handler.
+ *
+ * The positional payload of an event is converted straight into the
+ * parameters, which have to be default constructible.
+ *
+ * @throw std::invalid_argument from the wrapper if an event has the wrong
+ *        number of positional arguments
+ * @throw std::bad_cast from the wrapper if an argument does not convert
+ */
+template <typename... Args, typename Function>
+wamp_typed_event_handler make_typed_event_handler(Function handler);
+
+} // namespace autobahn
+
+#include "wamp_typed_event_handler.ipp"
+
+#endif // AUTOBAHN_WAMP_TYPED_EVENT_HANDLER_HPP
@@ -0,0 +1,70 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "wamp_typed_procedure.hpp"
+
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+namespace autobahn {
+
+namespace detail {
+
+template <typename Function, typename... Args>
+class typed_event_handler
+{
+public:
+    explicit typed_event_handler(Function handler)
+        : m_handler(std::move(handler))
+    {
+    }
+
+    void operator()(const msgpack::object& arguments)
+    {
+        uint32_t size = arguments.type == msgpack::type::ARRAY ? arguments.via.array.size : 0;
+        if (size != sizeof...(Args)) {
+            throw std::invalid_argument("wrong number of positional arguments for typed event handler");
+        }
+
+        typedef typename make_index_list<sizeof...(Args)>::type indices;
+        std::tuple<typename std::decay<Args>::type...> values;
+
+        convert_elements(size ? arguments.via.array.ptr : nullptr, values, indices());
+        call(values, indices());
+    }
+
+private:
+    template <typename Tuple, std::size_t... I>
+    void call(Tuple& values, index_list<I...>)
+    {
+        m_handler(std::get<I>(values)...);
+    }
+
+    Function m_handler;
+};
+
+} // namespace detail
+
+template <typename... Args, typename Function>
+inline wamp_typed_event_handler make_typed_event_handler(Function handler)
+{
+    return detail::typed_event_handler<Function, Args...>(std::move(handler));
+}
+
+} // namespace autobahn
@@ -0,0 +1,55 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_TYPED_PROCEDURE_HPP
+#define AUTOBAHN_WAMP_TYPED_PROCEDURE_HPP
+
+#include <cstdint>
+#include <functional>
+#include <msgpack.hpp>
+
+namespace autobahn {
+
+/*!
+ * A procedure registered with a typed signature, see wamp_session::provide.
+ *
+ * It decodes the positional arguments of an INVOCATION, runs the procedure and
+ * packs the YIELD or ERROR reply to the invocation into @p reply.
+ */
+typedef std::function<void(
+        uint64_t request_id, const msgpack::object& arguments, msgpack::sbuffer& reply)> wamp_typed_procedure;
+
+/*!
+ * Wrap @p procedure, callable with the parameters of @p Signature, into a
+ * wamp_typed_procedure.
+ *
+ * The positional arguments of an invocation are converted straight into the
+ * parameters, which have to be default constructible. An invocation with the
+ * wrong number of arguments, or with arguments that do not convert, is
+ * answered with "wamp.error.invalid_argument". Exceptions thrown by the
+ * procedure are answered with "wamp.error.runtime_error". The return value, if
+ * any, is yielded as the only positional result.
+ */
+template <typename Signature, typename Function>
+wamp_typed_procedure make_typed_procedure(Function procedure);
+
+} // namespace autobahn
+
+#include "wamp_typed_procedure.ipp"
+
+#endif // AUTOBAHN_WAMP_TYPED_PROCEDURE_HPP
@@ -0,0 +1,170 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#include "wamp_message_type.hpp"
+
+#include <exception>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+
+namespace autobahn {
+
+namespace detail {
+
+/// A compile time list of tuple indices.
+template <std::size_t... I>
+struct index_list
+{
+};
+
+template <std::size_t N, std::size_t... I>
+struct make_index_list : make_index_list<N - 1, N - 1, I...>
+{
+};
+
+template <std::size_t... I>
+struct make_index_list<0, I...>
+{
+    typedef index_list<I...> type;
+};
+
+/// Convert the elements of a msgpack array into the elements of a tuple.
+template <typename Tuple, std::size_t... I>
+inline void convert_elements(const msgpack::object* elements, Tuple& values, index_list<I...>)
+{
+    int expand[] = { 0, (elements[I].convert(std::get<I>(values)), 0)... };
+    (void) expand;
+}
+
+inline void pack_invocation_error(
+        msgpack::sbuffer& reply, uint64_t request_id, const char* error_uri, const char* what)
+{
+    msgpack::packer<msgpack::sbuffer> packer(reply);
+
+    // [ERROR, INVOCATION, INVOCATION.Request|id, Details|dict, Error|uri, Arguments|list, ArgumentsKw|dict]
+    packer.pack_array(7);
+    packer.pack(static_cast<int>(message_type::ERROR));
+    packer.pack(static_cast<int>(message_type::INVOCATION));
+    packer.pack(request_id);
+    packer.pack_map(0);
+    packer.pack(std::string(error_uri));
+    packer.pack_array(0);
+    packer.pack_map(1);
+    packer.pack(std::string("what"));
+    packer.pack(std::string(what));
+}
+
+/// Call the procedure and pack its return value into a YIELD.
+template <typename Result>
+struct yield_result
+{
+    template <typename Function, typename Tuple, std::size_t... I>
+    static void call(Function& procedure, Tuple& values, index_list<I...>,
+            msgpack::sbuffer& reply, uint64_t request_id)
+    {
+        Result result = procedure(std::get<I>(values)...);
+
+        msgpack::packer<msgpack::sbuffer> packer(reply);
+
+        // [YIELD, INVOCATION.Request|id, Options|dict, Arguments|list]
+        packer.pack_array(4);
+        packer.pack(static_cast<int>(message_type::YIELD));
+        packer.pack(request_id);
+        packer.pack_map(0);
+        packer.pack_array(1);
+        packer.pack(result);
+    }
+};
+
+template <>
+struct yield_result<void>
+{
+    template <typename Function, typename Tuple, std::size_t... I>
+    static void call(Function& procedure, Tuple& values, index_list<I...>,
+            msgpack::sbuffer& reply, uint64_t request_id)
+    {
+        procedure(std::get<I>(values)...);
+
+        msgpack::packer<msgpack::sbuffer> packer(reply);
+
+        // [YIELD, INVOCATION.Request|id, Options|dict]
+        packer.pack_array(3);
+        packer.pack(static_cast<int>(message_type::YIELD));
+        packer.pack(request_id);
+        packer.pack_map(0);
+    }
+};
+
+template <typename Signature, typename Function>
+class typed_procedure;
+
+template <typename Result, typename... Args, typename Function>
+class typed_procedure<Result(Args...), Function>
+{
+public:
+    explicit typed_procedure(Function procedure)
+        : m_procedure(std::move(procedure))
+    {
+    }
+
+    void operator()(uint64_t request_id, const msgpack::object& arguments, msgpack::sbuffer& reply)
+    {
+        uint32_t size = arguments.type == msgpack::type::ARRAY ? arguments.via.array.size : 0;
+        if (size != sizeof...(Args)) {
+            pack_invocation_error(reply, request_id, "wamp.error.invalid_argument",
+                    "wrong number of positional arguments");
+            return;
+        }
+
+        typedef typename make_index_list<sizeof...(Args)>::type indices;
+        std::tuple<typename std::decay<Args>::type...> values;
+
+        try {
+            convert_elements(size ? arguments.via.array.ptr : nullptr, values, indices());
+        } catch (const std::bad_cast&) {
+            pack_invocation_error(reply, request_id, "wamp.error.invalid_argument",
+                    "positional argument of wrong type");
+            return;
+        }
+
+        try {
+            yield_result<Result>::call(m_procedure, values, indices(), reply, request_id);
+        } catch (const std::exception& e) {
+            reply.clear();
+            pack_invocation_error(reply, request_id, "wamp.error.runtime_error", e.what());
+        } catch (...) {
+            reply.clear();
+            pack_invocation_error(reply, request_id, "wamp.error.runtime_error", "unknown exception");
+        }
+    }
+
+private:
+    Function m_procedure;
+};
+
+} // namespace detail
+
+template <typename Signature, typename Function>
+inline wamp_typed_procedure make_typed_procedure(Function procedure)
+{
+    return detail::typed_procedure<Signature, Function>(std::move(procedure));
+}
+
+} // namespace autobahn
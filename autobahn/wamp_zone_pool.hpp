@@ -0,0 +1,87 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+#ifndef AUTOBAHN_WAMP_ZONE_POOL_HPP
+#define AUTOBAHN_WAMP_ZONE_POOL_HPP
+
+#include <cstddef>
+#include <memory>
+#include <msgpack.hpp>
+#include <mutex>
+#include <vector>
+
+namespace autobahn {
+
+/*!
+ * A pool of msgpack zones for unpacking received messages.
+ *
+ * Zones are handed out as shared pointers. When the last owner (a call result,
+ * an event or an invocation) releases a zone, the zone is cleared and goes back
+ * to the pool, keeping its first chunk so the next message unpacked into it does
+ * not hit the allocator. Zones may be released on any thread.
+ *
+ * Idle zones are accounted at the chunk size. Once the idle zones reach the
+ * retained bytes limit, released zones are freed instead of pooled. Messages that
+ * are too large to fit a chunk comfortably get a zone of their own, which is never
+ * pooled, so one large message can't pin a large chunk in the pool.
+ */
+class wamp_zone_pool
+{
+public:
+    static const std::size_t DEFAULT_MAX_RETAINED_BYTES = 64 * MSGPACK_ZONE_CHUNK_SIZE;
+
+    wamp_zone_pool(
+            std::size_t chunk_size = MSGPACK_ZONE_CHUNK_SIZE,
+            std::size_t max_retained_bytes = DEFAULT_MAX_RETAINED_BYTES);
+
+    /*!
+     * A zone to unpack a message of @p message_size octets into.
+     */
+    std::shared_ptr<msgpack::zone> acquire(std::size_t message_size);
+
+    /*!
+     * The number of octets retained by idle zones.
+     */
+    std::size_t retained_bytes() const;
+
+    /*!
+     * Set the limit of octets retained by idle zones. Lowering the limit frees
+     * idle zones above it right away; zero disables pooling.
+     */
+    void set_max_retained_bytes(std::size_t max_retained_bytes);
+
+private:
+    /// State shared with the deleters of outstanding zones, which may outlive the pool.
+    struct state
+    {
+        std::size_t chunk_size;
+        std::size_t max_retained_bytes;
+        std::vector<std::unique_ptr<msgpack::zone>> idle;
+        std::mutex mutex;
+    };
+
+    static void release(const std::weak_ptr<state>& weak_state, msgpack::zone* zone);
+
+    std::shared_ptr<state> m_state;
+};
+
+} // namespace autobahn
+
+#include "wamp_zone_pool.ipp"
+
+#endif // AUTOBAHN_WAMP_ZONE_POOL_HPP
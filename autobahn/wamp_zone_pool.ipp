@@ -0,0 +1,95 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+namespace autobahn {
+
+inline wamp_zone_pool::wamp_zone_pool(std::size_t chunk_size, std::size_t max_retained_bytes)
+    : m_state(std::make_shared<state>())
+{
+    m_state->chunk_size = chunk_size;
+    m_state->max_retained_bytes = max_retained_bytes;
+}
+
+inline std::shared_ptr<msgpack::zone> wamp_zone_pool::acquire(std::size_t message_size)
+{
+    // Unpacking expands a message, so only messages well below the chunk size
+    // are expected to stay within the first chunk.
+    if (message_size > m_state->chunk_size / 4) {
+        return std::make_shared<msgpack::zone>(m_state->chunk_size);
+    }
+
+    std::unique_ptr<msgpack::zone> zone;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        if (!m_state->idle.empty()) {
+            zone = std::move(m_state->idle.back());
+            m_state->idle.pop_back();
+        }
+    }
+
+    if (!zone) {
+        zone.reset(new msgpack::zone(m_state->chunk_size));
+    }
+
+    std::weak_ptr<state> weak_state = m_state;
+    return std::shared_ptr<msgpack::zone>(zone.release(), [weak_state](msgpack::zone* released) {
+        release(weak_state, released);
+    });
+}
+
+inline std::size_t wamp_zone_pool::retained_bytes() const
+{
+    std::lock_guard<std::mutex> lock(m_state->mutex);
+    return m_state->idle.size() * m_state->chunk_size;
+}
+
+inline void wamp_zone_pool::set_max_retained_bytes(std::size_t max_retained_bytes)
+{
+    std::vector<std::unique_ptr<msgpack::zone>> surplus;
+    {
+        std::lock_guard<std::mutex> lock(m_state->mutex);
+        m_state->max_retained_bytes = max_retained_bytes;
+
+        std::size_t max_idle = max_retained_bytes / m_state->chunk_size;
+        while (m_state->idle.size() > max_idle) {
+            surplus.push_back(std::move(m_state->idle.back()));
+            m_state->idle.pop_back();
+        }
+    }
+    // surplus zones are freed here, outside of the lock
+}
+
+inline void wamp_zone_pool::release(const std::weak_ptr<state>& weak_state, msgpack::zone* zone)
+{
+    std::unique_ptr<msgpack::zone> released(zone);
+
+    auto shared_state = weak_state.lock();
+    if (!shared_state) {
+        return;
+    }
+
+    // Runs the finalizers and frees all chunks but the first one.
+    released->clear();
+
+    std::lock_guard<std::mutex> lock(shared_state->mutex);
+    if ((shared_state->idle.size() + 1) * shared_state->chunk_size <= shared_state->max_retained_bytes) {
+        shared_state->idle.push_back(std::move(released));
+    }
+}
+
+} // namespace autobahn
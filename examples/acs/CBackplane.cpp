@@ -33,14 +33,13 @@ void CBackplane::proxy(autobahn::wamp_invocation invocation) {
 
         if (itt != m_sessionMap.end() && itt->second->isConnected()) {
             std::cerr << "Calling " << procedureName << " on " << domainName << std::endl;
-            boost::future<autobahn::wamp_call_result> callFuture = (*(itt->second))->call(procedureName,
-                                                                                          invocation->arguments<std::list<msgpack::object>>(),
-                                                                                          invocation->kw_arguments<std::unordered_map<std::string, msgpack::object>>());
+            boost::future<autobahn::wamp_call_result> callFuture = (*(itt->second))->call_raw(procedureName,
+                                                                                              invocation->raw_arguments(),
+                                                                                              invocation->raw_kw_arguments());
             std::thread([&callFuture, invocation] {
                 std::cerr << "Called" << std::endl;
                 autobahn::wamp_call_result result = callFuture.get();
-                invocation->result(result.arguments<std::list<msgpack::object>>(),
-                                   result.kw_arguments<std::unordered_map<std::string, msgpack::object>>());
+                invocation->result_raw(result.raw_arguments(), result.raw_kw_arguments());
                 std::cerr << "sent proxy reply" << std::endl;
                 //TODO: Send back error if one was present (seemingly not currently supported by autobahnCpp)
             }).detach();
@@ -0,0 +1,81 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Compares converting keyword arguments to autobahn::wamp_kw_view with the
+// std::unordered_map<std::string, msgpack::object> conversion used so far,
+// for a message with 80 keyword arguments of which a handler reads two.
+
+#include <autobahn/wamp_kw_view.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <msgpack.hpp>
+#include <string>
+#include <unordered_map>
+
+static const int FIELDS = 80;
+static const int ROUNDS = 100000;
+
+template <typename Function>
+static double measure(const char* name, Function function)
+{
+   auto start = std::chrono::steady_clock::now();
+   int64_t checksum = 0;
+   for (int i = 0; i < ROUNDS; ++i) {
+      checksum += function();
+   }
+   std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+   double per_round = elapsed.count() / ROUNDS;
+   std::cout << name << ": " << per_round << " ns per message (checksum " << checksum << ")" << std::endl;
+   return per_round;
+}
+
+int main() {
+   std::unordered_map<std::string, int> fields;
+   for (int i = 0; i < FIELDS; ++i) {
+      fields["field_" + std::to_string(i)] = i;
+   }
+
+   msgpack::sbuffer buffer;
+   msgpack::pack(buffer, fields);
+   msgpack::unpacked unpacked;
+   msgpack::unpack(unpacked, buffer.data(), buffer.size());
+   const msgpack::object& kw_arguments = unpacked.get();
+
+   double map_time = measure("std::unordered_map", [&]() {
+      auto kw = kw_arguments.as<std::unordered_map<std::string, msgpack::object>>();
+      return kw.at("field_7").as<int>() + kw.at("field_42").as<int>();
+   });
+
+   double view_time = measure("autobahn::wamp_kw_view", [&]() {
+      auto kw = kw_arguments.as<autobahn::wamp_kw_view>();
+      return kw.at("field_7").as<int>() + kw.at("field_42").as<int>();
+   });
+
+   msgpack::sbuffer repacked;
+   msgpack::pack(repacked, kw_arguments.as<autobahn::wamp_kw_view>());
+   if (repacked.size() != buffer.size()) {
+      std::cerr << "FAIL: repacked view differs in size from the original map" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   std::cout << "speedup: " << map_time / view_time << "x" << std::endl;
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,91 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Compares packing 100k float samples as a std::vector<float>, one msgpack
+// element per sample, with packing them as an autobahn::wamp_typed_array, and
+// checks that the typed array reads back unchanged.
+
+#include <autobahn/wamp_typed_array.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <msgpack.hpp>
+#include <vector>
+
+static const std::size_t SAMPLES = 100000;
+static const int ROUNDS = 200;
+
+template <typename Function>
+static double measure(const char* name, Function function)
+{
+   auto start = std::chrono::steady_clock::now();
+   std::size_t bytes = 0;
+   for (int i = 0; i < ROUNDS; ++i) {
+      bytes = function();
+   }
+   std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+
+   double per_round = elapsed.count() / ROUNDS;
+   std::cout << name << ": " << per_round << " us per frame, " << bytes << " bytes" << std::endl;
+   return per_round;
+}
+
+int main() {
+   std::vector<float> samples(SAMPLES);
+   for (std::size_t i = 0; i < SAMPLES; ++i) {
+      samples[i] = static_cast<float>(i) * 0.25f - 1000.0f;
+   }
+
+   double vector_time = measure("std::vector<float>", [&]() {
+      msgpack::sbuffer buffer;
+      msgpack::pack(buffer, samples);
+      return buffer.size();
+   });
+
+   double typed_time = measure("autobahn::wamp_typed_array<float>", [&]() {
+      msgpack::sbuffer buffer;
+      msgpack::pack(buffer, autobahn::wamp_typed_array<float>(samples));
+      return buffer.size();
+   });
+
+   std::cout << "speedup: " << vector_time / typed_time << "x" << std::endl;
+
+   std::vector<uint32_t> shape = { 1000, 100 };
+   msgpack::sbuffer buffer;
+   msgpack::pack(buffer, autobahn::wamp_typed_array<float>(samples.data(), shape));
+
+   msgpack::unpacked unpacked;
+   msgpack::unpack(unpacked, buffer.data(), buffer.size());
+   auto view = unpacked.get().as<autobahn::wamp_typed_array_view<float>>();
+   if (view.rank() != 2 || view.dimension(0) != 1000 || view.dimension(1) != 100
+         || view.to_vector() != samples || view[12345] != samples[12345])
+   {
+      std::cerr << "FAIL: typed array did not read back unchanged" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   try {
+      unpacked.get().as<autobahn::wamp_typed_array_view<double>>();
+      std::cerr << "FAIL: float array read as double array" << std::endl;
+      return EXIT_FAILURE;
+   } catch (const msgpack::type_error&) {
+   }
+
+   return EXIT_SUCCESS;
+}
@@ -0,0 +1,149 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Packs batches of PUBLISH and CALL messages, assigns their request IDs and
+// splits the frames at their length prefixes again, unpacking each message the
+// way a router would.
+
+#include <autobahn/autobahn.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/*!
+ * Check that @p frames holds exactly one length prefixed message of type @p code
+ * per URI in @p uris, with consecutive request IDs from @p first_request_id.
+ */
+static bool check_frames(const char* name, const msgpack::sbuffer& frames,
+      autobahn::message_type code, const std::vector<std::string>& uris, uint64_t first_request_id)
+{
+   const char* data = frames.data();
+   std::size_t offset = 0;
+
+   for (std::size_t i = 0; i < uris.size(); ++i) {
+      if (frames.size() - offset < 4) {
+         std::cerr << "FAIL: " << name << ": frame " << i << " missing" << std::endl;
+         return false;
+      }
+
+      const unsigned char* prefix = reinterpret_cast<const unsigned char*>(data + offset);
+      std::size_t length = (std::size_t(prefix[0]) << 24) | (std::size_t(prefix[1]) << 16)
+            | (std::size_t(prefix[2]) << 8) | std::size_t(prefix[3]);
+      offset += 4;
+
+      if (frames.size() - offset < length) {
+         std::cerr << "FAIL: " << name << ": frame " << i << " longer than the batch" << std::endl;
+         return false;
+      }
+
+      std::size_t message_end = 0;
+      msgpack::unpacked unpacked;
+      msgpack::unpack(unpacked, data + offset, length, message_end);
+      if (message_end != length) {
+         std::cerr << "FAIL: " << name << ": length prefix of frame " << i
+                   << " does not match its message" << std::endl;
+         return false;
+      }
+
+      const msgpack::object& message = unpacked.get();
+      if (message.type != msgpack::type::ARRAY || message.via.array.size < 4
+            || message.via.array.ptr[0].as<int>() != static_cast<int>(code))
+      {
+         std::cerr << "FAIL: " << name << ": frame " << i << " has the wrong message type" << std::endl;
+         return false;
+      }
+
+      // The request ID placeholder is a uint64 right after the array header and
+      // the message code, patched in place with the big endian ID.
+      if (static_cast<unsigned char>(data[offset + 2]) != 0xcf
+            || message.via.array.ptr[1].as<uint64_t>() != first_request_id + i)
+      {
+         std::cerr << "FAIL: " << name << ": frame " << i << " has the wrong request ID" << std::endl;
+         return false;
+      }
+
+      if (message.via.array.ptr[3].as<std::string>() != uris[i]) {
+         std::cerr << "FAIL: " << name << ": frame " << i << " has the wrong URI" << std::endl;
+         return false;
+      }
+
+      offset += length;
+   }
+
+   if (offset != frames.size()) {
+      std::cerr << "FAIL: " << name << ": trailing bytes after the last frame" << std::endl;
+      return false;
+   }
+   return true;
+}
+
+int main() {
+   int failures = 0;
+
+   // Every octet of the request IDs differs, so a byte order mix-up shows.
+   const uint64_t first_request_id = 0x0102030405060708ULL;
+
+   const std::vector<int> arguments = { 1, 2, 3 };
+   std::map<std::string, std::string> kw_arguments;
+   kw_arguments["key"] = "value";
+
+   {
+      autobahn::wamp_publish_batch batch;
+      batch.publish("com.example.a");
+      batch.publish("com.example.b", arguments);
+      batch.publish("com.example.c", arguments, kw_arguments);
+
+      batch.frames().set_request_ids(first_request_id);
+      if (batch.size() != 3 || !check_frames("publish batch", *batch.frames().frames(),
+               autobahn::message_type::PUBLISH,
+               { "com.example.a", "com.example.b", "com.example.c" }, first_request_id))
+      {
+         ++failures;
+      }
+   }
+
+   {
+      autobahn::wamp_call_batch batch;
+      batch.call("com.example.f");
+      batch.call("com.example.g", arguments);
+      batch.call("com.example.h", arguments, kw_arguments);
+
+      batch.frames().set_request_ids(first_request_id);
+      if (batch.size() != 3 || !check_frames("call batch", *batch.frames().frames(),
+               autobahn::message_type::CALL,
+               { "com.example.f", "com.example.g", "com.example.h" }, first_request_id))
+      {
+         ++failures;
+      }
+   }
+
+   {
+      autobahn::wamp_call_batch batch;
+      batch.frames().set_request_ids(first_request_id);
+      if (!batch.empty() || batch.frames().frames()->size() != 0) {
+         std::cerr << "FAIL: empty batch has frames" << std::endl;
+         ++failures;
+      }
+   }
+
+   return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,100 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Checks that an invocation queue counts an invocation against its concurrency
+// limit until the invocation has been answered or destroyed, not just while the
+// procedure runs.
+
+#include <autobahn/autobahn.hpp>
+
+#include <boost/asio.hpp>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <vector>
+
+int main() {
+   int failures = 0;
+
+   auto expect = [&](const char* name, bool condition) {
+      if (!condition) {
+         std::cerr << "FAIL: " << name << std::endl;
+         ++failures;
+      }
+   };
+
+   auto executor = std::make_shared<boost::asio::io_service>();
+   autobahn::wamp_invocation_options options;
+   options.set_executor(executor);
+   options.set_max_concurrency(1);
+   options.set_max_queued(4);
+
+   std::map<const autobahn::wamp_invocation_impl*, uint64_t> request_ids;
+   std::vector<uint64_t> executed;
+   std::vector<uint64_t> answered;
+
+   // The procedure answers later, outside of the executor.
+   std::vector<autobahn::wamp_invocation> deferred;
+   auto queue = std::make_shared<autobahn::wamp_invocation_queue>(
+         [&](autobahn::wamp_invocation invocation) {
+            executed.push_back(request_ids[invocation.get()]);
+            deferred.push_back(invocation);
+         },
+         options);
+
+   auto push = [&](uint64_t request_id) {
+      auto invocation = std::make_shared<autobahn::wamp_invocation_impl>();
+      invocation->set_request_id(request_id);
+      request_ids[invocation.get()] = request_id;
+      invocation->set_send_result_fn(
+            [&answered, request_id](const std::shared_ptr<msgpack::sbuffer>&) {
+               answered.push_back(request_id);
+            });
+      queue->push(invocation);
+   };
+
+   auto run = [&]() {
+      executor->reset();
+      executor->run();
+   };
+
+   push(1);
+   push(2);
+   push(3);
+   run();
+   expect("unanswered invocation keeps its slot", executed.size() == 1 && executed[0] == 1);
+
+   // Answering the invocation frees its slot for the next one.
+   deferred[0]->empty_result();
+   run();
+   expect("answered invocation frees its slot", executed.size() == 2 && executed[1] == 2);
+
+   // So does dropping an invocation without answering it.
+   deferred.clear();
+   run();
+   expect("destroyed invocation frees its slot", executed.size() == 3 && executed[2] == 3);
+   expect("only the answered invocation answered", answered.size() == 1 && answered[0] == 1);
+
+   deferred[0]->empty_result();
+   push(4);
+   run();
+   expect("slot free after the queue drained", executed.size() == 4 && executed[3] == 4);
+
+   return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
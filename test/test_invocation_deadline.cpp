@@ -0,0 +1,145 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Checks that invocations pick up the caller's timeout from their details, and
+// that an invocation queue answers invocations whose caller has given up with
+// the timeout error instead of running them.
+
+#include <autobahn/autobahn.hpp>
+
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Details of an INVOCATION whose caller waits @p timeout_ms milliseconds.
+static msgpack::object timeout_details(int timeout_ms, msgpack::zone& zone)
+{
+   std::map<std::string, int> details;
+   details["timeout"] = timeout_ms;
+   return msgpack::object(details, zone);
+}
+
+/// The error URI of a packed [ERROR, INVOCATION, Request, Details, Error] message.
+static std::string error_uri(const std::shared_ptr<msgpack::sbuffer>& buffer)
+{
+   autobahn::wamp_msgpack_cursor message(autobahn::wamp_msgpack_span(buffer->data(), buffer->size()));
+   autobahn::wamp_msgpack_span uri = message.element(4);
+   autobahn::detail::msgpack_header header = autobahn::detail::read_msgpack_header(uri.data(), uri.size(), 0);
+   return std::string(uri.data() + header.header_size, header.body_size);
+}
+
+int main() {
+   int failures = 0;
+
+   auto expect = [&](const char* name, bool condition) {
+      if (!condition) {
+         std::cerr << "FAIL: " << name << std::endl;
+         ++failures;
+      }
+   };
+
+   msgpack::zone zone;
+
+   // set_details() turns the caller's relative timeout into a deadline
+   {
+      auto invocation = std::make_shared<autobahn::wamp_invocation_impl>();
+      expect("no deadline without details", !invocation->has_deadline() && !invocation->expired());
+
+      invocation->set_details(timeout_details(50, zone));
+      expect("deadline from timeout", invocation->has_deadline());
+      expect("not expired before timeout", !invocation->expired());
+      expect("remaining time before timeout", invocation->remaining_time() > std::chrono::milliseconds(0)
+            && invocation->remaining_time() <= std::chrono::milliseconds(50));
+
+      std::this_thread::sleep_for(std::chrono::milliseconds(60));
+      expect("expired after timeout", invocation->expired());
+      expect("no remaining time after timeout", invocation->remaining_time() == std::chrono::milliseconds(0));
+   }
+
+   // A waiting invocation whose caller times out is answered with the timeout error
+   {
+      auto executor = std::make_shared<boost::asio::io_service>();
+      autobahn::wamp_invocation_options options;
+      options.set_executor(executor);
+      options.set_max_concurrency(1);
+      options.set_max_queued(1);
+
+      std::map<const autobahn::wamp_invocation_impl*, uint64_t> request_ids;
+      std::vector<uint64_t> executed;
+      std::map<uint64_t, std::shared_ptr<msgpack::sbuffer>> answers;
+
+      auto queue = std::make_shared<autobahn::wamp_invocation_queue>(
+            [&](autobahn::wamp_invocation invocation) {
+               executed.push_back(request_ids[invocation.get()]);
+               invocation->empty_result();
+            },
+            options);
+
+      auto make_invocation = [&](uint64_t request_id, int timeout_ms) {
+         auto invocation = std::make_shared<autobahn::wamp_invocation_impl>();
+         invocation->set_request_id(request_id);
+         request_ids[invocation.get()] = request_id;
+         if (timeout_ms > 0) {
+            invocation->set_details(timeout_details(timeout_ms, zone));
+         }
+         invocation->set_send_result_fn(
+               [&answers, request_id](const std::shared_ptr<msgpack::sbuffer>& buffer) {
+                  answers[request_id] = buffer;
+               });
+         return invocation;
+      };
+
+      // 1 takes the only execution slot, 2 waits for it and times out meanwhile.
+      queue->push(make_invocation(1, 0));
+      queue->push(make_invocation(2, 10));
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      executor->run();
+
+      expect("first invocation executed", executed.size() == 1 && executed[0] == 1);
+      expect("expired invocation answered", answers.count(2) == 1);
+      if (answers.count(2)) {
+         expect("expired invocation answered with timeout error",
+               error_uri(answers[2]) == options.timeout_error());
+      }
+
+      // With the queue full, an expired waiting invocation makes room at once.
+      executor->reset();
+      queue->push(make_invocation(3, 0));
+      queue->push(make_invocation(4, 10));
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      queue->push(make_invocation(5, 0));
+
+      expect("expired invocation purged from full queue", answers.count(4) == 1);
+      if (answers.count(4)) {
+         expect("purged invocation answered with timeout error",
+               error_uri(answers[4]) == options.timeout_error());
+      }
+      expect("invocation behind purged one not rejected", answers.count(5) == 0);
+
+      executor->run();
+      expect("remaining invocations executed", executed.size() == 3 && executed[1] == 3 && executed[2] == 5);
+   }
+
+   return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,94 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Feeds well-formed and malformed WAMP messages, encoded by hand, to the frame
+// validator the session runs before unpacking received messages.
+
+#include <autobahn/autobahn.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+static bool accepted(const std::string& message)
+{
+   try {
+      return autobahn::detail::validate_wamp_message(message.data(), message.size(), 0) == message.size();
+   } catch (const autobahn::protocol_error&) {
+      return false;
+   }
+}
+
+int main() {
+   int failures = 0;
+
+   auto expect = [&](const char* name, const std::string& message, bool valid) {
+      if (accepted(message) != valid) {
+         std::cerr << "FAIL: " << name << " should be " << (valid ? "accepted" : "rejected") << std::endl;
+         ++failures;
+      }
+   };
+
+   // [EVENT, 1, 2, {}]
+   expect("EVENT without payload", std::string("\x94\x24\x01\x02\x80", 5), true);
+
+   // [EVENT, 1, 2, {}, [1], {"a": 1}]
+   expect("EVENT with payload", std::string("\x96\x24\x01\x02\x80\x91\x01\x81\xa1" "a" "\x01", 11), true);
+
+   // [RESULT, 300, {}, [1]] with the request ID as uint16
+   expect("RESULT", std::string("\x94\x32\xcd\x01\x2c\x80\x91\x01", 8), true);
+
+   // [EVENT, 1, 2, {}] with the code as int8 and the publication ID as int64
+   expect("EVENT with signed integer formats",
+         std::string("\x94\xd0\x24\x01\xd3\x00\x00\x00\x00\x00\x00\x00\x02\x80", 14), true);
+
+   // [RESULT, 300, {}] with the request ID as int16
+   expect("RESULT with int16 ID", std::string("\x93\x32\xd1\x01\x2c\x80", 6), true);
+
+   // [EVENT, -1, 2, {}]: a negative int8 is not an ID
+   expect("EVENT with negative ID", std::string("\x94\x24\xd0\xff\x02\x80", 6), false);
+
+   // [EVENT, 1, 2, {}, {}]: arguments must be a list
+   expect("EVENT with map arguments", std::string("\x95\x24\x01\x02\x80\x80", 6), false);
+
+   // [EVENT, 1, 2]: too short
+   expect("short EVENT", std::string("\x93\x24\x01\x02", 4), false);
+
+   // [EVENT, "1", 2, {}]: subscription ID must be an integer
+   expect("EVENT with string ID", std::string("\x94\x24\xa1" "1" "\x02\x80", 6), false);
+
+   // [99, 1]: unknown message code
+   expect("unknown code", std::string("\x92\x63\x01", 3), false);
+
+   // [EVENT, 1, 2, {}, [<2^32-1 elements>]]: array claiming far more than was received
+   expect("oversized array", std::string("\x95\x24\x01\x02\x80\xdd\xff\xff\xff\xff\x01", 11), false);
+
+   // [EVENT, 1, 2, {}, [1, 2: truncated
+   expect("truncated EVENT", std::string("\x95\x24\x01\x02\x80\x93\x01\x02", 8), false);
+
+   // invalid format byte 0xc1
+   expect("invalid format byte", std::string("\x92\x24\xc1", 3), false);
+
+   // {}: not an array
+   expect("map message", std::string("\x80", 1), false);
+
+   // [CALL, 1, {}, "p"] is well-formed; got_message() rejects it by code
+   expect("CALL", std::string("\x94\x30\x01\x80\xa1" "p", 6), true);
+
+   return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,217 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Checks that a progressive call timing out while its results are still
+// streaming in leaves the session intact: the progressive results and the final
+// ERROR the dealer sends after the CANCEL are dropped, and later calls work.
+//
+// The test plays the router itself, on the other end of a loopback connection.
+
+#include <autobahn/autobahn.hpp>
+
+#include <arpa/inet.h>
+#include <atomic>
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <thread>
+#include <vector>
+
+using boost::asio::ip::tcp;
+
+typedef autobahn::wamp_session<tcp::socket, tcp::socket> session_type;
+
+/// Read one length prefixed message sent by the session and unpack it.
+static msgpack::object read_message(tcp::socket& router, msgpack::unpacked& unpacked)
+{
+   uint32_t length;
+   boost::asio::read(router, boost::asio::buffer(&length, sizeof(length)));
+
+   std::vector<char> message(ntohl(length));
+   boost::asio::read(router, boost::asio::buffer(message));
+
+   msgpack::unpack(unpacked, message.data(), message.size());
+   return unpacked.get();
+}
+
+/// Send one message to the session, length prefixed.
+static void write_message(tcp::socket& router, const msgpack::sbuffer& message)
+{
+   uint32_t length = htonl(static_cast<uint32_t>(message.size()));
+   boost::asio::write(router, boost::asio::buffer(&length, sizeof(length)));
+   boost::asio::write(router, boost::asio::buffer(message.data(), message.size()));
+}
+
+/// Send [RESULT, CALL.Request|id, Details|dict, YIELD.Arguments|list] with one argument.
+static void write_result(tcp::socket& router, uint64_t request_id, bool progress, int argument)
+{
+   msgpack::sbuffer result;
+   msgpack::packer<msgpack::sbuffer> packer(result);
+
+   packer.pack_array(4);
+   packer.pack(static_cast<int>(autobahn::message_type::RESULT));
+   packer.pack(request_id);
+   if (progress) {
+      packer.pack_map(1);
+      packer.pack(std::string("progress"));
+      packer.pack(true);
+   } else {
+      packer.pack_map(0);
+   }
+   packer.pack_array(1);
+   packer.pack(argument);
+   write_message(router, result);
+}
+
+int main() {
+   boost::asio::io_service io;
+   tcp::acceptor acceptor(io, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+   tcp::socket socket(io);
+   tcp::socket router(io);
+   socket.connect(acceptor.local_endpoint());
+   acceptor.accept(router);
+
+   // A session that died stops sending; fail instead of waiting for it forever.
+   struct timeval receive_timeout = { 5, 0 };
+   setsockopt(router.native_handle(), SOL_SOCKET, SO_RCVTIMEO, &receive_timeout, sizeof(receive_timeout));
+
+   auto session = std::make_shared<session_type>(io, socket, socket);
+
+   std::atomic<bool> io_failed(false);
+   std::thread io_thread;
+   int failures = 0;
+
+   try {
+      boost::future<bool> started = session->start();
+      unsigned char handshake[4];
+      boost::asio::read(router, boost::asio::buffer(handshake));
+      const unsigned char handshake_reply[4] = { 0x7F, 0xF2, 0x00, 0x00 };
+      boost::asio::write(router, boost::asio::buffer(handshake_reply));
+
+      io_thread = std::thread([&io, &io_failed]() {
+         try {
+            io.run();
+         } catch (const std::exception& e) {
+            std::cerr << "FAIL: session io loop ended by: " << e.what() << std::endl;
+            io_failed = true;
+         }
+      });
+
+      if (!started.get()) {
+         throw std::runtime_error("RawSocket handshake failed");
+      }
+
+      boost::future<uint64_t> joined = session->join("realm1");
+      msgpack::unpacked hello;
+      read_message(router, hello);
+      {
+         msgpack::sbuffer welcome;
+         msgpack::packer<msgpack::sbuffer> packer(welcome);
+
+         // [WELCOME, Session|id, Details|dict]
+         packer.pack_array(3);
+         packer.pack(static_cast<int>(autobahn::message_type::WELCOME));
+         packer.pack(1);
+         packer.pack_map(0);
+         write_message(router, welcome);
+      }
+      joined.get();
+
+      // A progressive call that times out after its first result.
+      std::atomic<int> progress_results(0);
+      autobahn::wamp_call_options options;
+      options.set_timeout(std::chrono::milliseconds(20));
+      options.set_progress_handler([&progress_results](const autobahn::wamp_call_result&) {
+         ++progress_results;
+      });
+
+      boost::future<autobahn::wamp_call_result> streaming = session->call("com.example.stream", options);
+      msgpack::unpacked call;
+      uint64_t request_id = read_message(router, call).via.array.ptr[1].as<uint64_t>();
+      write_result(router, request_id, true, 1);
+
+      try {
+         streaming.get();
+         std::cerr << "FAIL: progressive call did not time out" << std::endl;
+         ++failures;
+      } catch (const autobahn::timeout_error&) {
+      }
+      int progress_at_timeout = progress_results;
+
+      msgpack::unpacked cancel;
+      if (read_message(router, cancel).via.array.ptr[0].as<int>() != static_cast<int>(autobahn::message_type::CANCEL)) {
+         std::cerr << "FAIL: timed out call not canceled" << std::endl;
+         ++failures;
+      }
+
+      // The dealer has more results in flight, then answers the CANCEL.
+      write_result(router, request_id, true, 2);
+      write_result(router, request_id, true, 3);
+      {
+         msgpack::sbuffer error;
+         msgpack::packer<msgpack::sbuffer> packer(error);
+
+         // [ERROR, CALL, CALL.Request|id, Details|dict, Error|uri]
+         packer.pack_array(5);
+         packer.pack(static_cast<int>(autobahn::message_type::ERROR));
+         packer.pack(static_cast<int>(autobahn::message_type::CALL));
+         packer.pack(request_id);
+         packer.pack_map(0);
+         packer.pack(std::string("wamp.error.canceled"));
+         write_message(router, error);
+      }
+
+      // The session still takes and completes calls.
+      boost::future<autobahn::wamp_call_result> ping = session->call("com.example.ping");
+      msgpack::unpacked ping_call;
+      write_result(router, read_message(router, ping_call).via.array.ptr[1].as<uint64_t>(), false, 42);
+
+      if (ping.get().argument<int>(0) != 42) {
+         std::cerr << "FAIL: call after the timed out progressive call not answered" << std::endl;
+         ++failures;
+      }
+
+      if (progress_results != progress_at_timeout) {
+         std::cerr << "FAIL: progressive results delivered after the timeout" << std::endl;
+         ++failures;
+      }
+   } catch (const std::exception& e) {
+      std::cerr << "FAIL: " << e.what() << std::endl;
+      ++failures;
+   }
+
+   if (failures || io_failed) {
+      io.stop();
+      if (io_thread.joinable()) {
+         io_thread.join();
+      }
+      return EXIT_FAILURE;
+   }
+
+   session->leave();
+   session->stop().get();
+   io_thread.join();
+
+   std::cout << "OK" << std::endl;
+   return EXIT_SUCCESS;
+}
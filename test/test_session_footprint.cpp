@@ -0,0 +1,226 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Checks that a session in lean mode stays within its memory budget while idle,
+// which is what allows a process to hold tens of thousands of client sessions,
+// and returns to it after receiving a large message and after a call timed out
+// and was canceled.
+//
+// The test plays the router itself, on the other end of a loopback connection.
+
+#include <autobahn/autobahn.hpp>
+
+#include <arpa/inet.h>
+#include <boost/asio.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <future>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using boost::asio::ip::tcp;
+
+typedef autobahn::wamp_session<tcp::socket, tcp::socket> session_type;
+
+/// Octets an idle lean session may occupy.
+static const std::size_t IDLE_SESSION_BUDGET = 4096;
+
+/// Octets of the payload of the large message, far above the receive buffer limit.
+static const std::size_t LARGE_PAYLOAD_SIZE = 1024 * 1024;
+
+/// Read one length prefixed message sent by the session.
+static std::vector<char> read_message(tcp::socket& router)
+{
+   uint32_t length;
+   boost::asio::read(router, boost::asio::buffer(&length, sizeof(length)));
+
+   std::vector<char> message(ntohl(length));
+   boost::asio::read(router, boost::asio::buffer(message));
+   return message;
+}
+
+/// Send one message to the session, length prefixed.
+static void write_message(tcp::socket& router, const msgpack::sbuffer& message)
+{
+   uint32_t length = htonl(static_cast<uint32_t>(message.size()));
+   boost::asio::write(router, boost::asio::buffer(&length, sizeof(length)));
+   boost::asio::write(router, boost::asio::buffer(message.data(), message.size()));
+}
+
+/// The request ID of a CALL message.
+static uint64_t request_id_of(const std::vector<char>& call)
+{
+   msgpack::unpacked unpacked;
+   msgpack::unpack(unpacked, call.data(), call.size());
+   return unpacked.get().via.array.ptr[1].as<uint64_t>();
+}
+
+/// Measure the footprint on the io thread, after the handler that is running there.
+static std::size_t footprint_of(boost::asio::io_service& io, const std::shared_ptr<session_type>& session)
+{
+   std::promise<std::size_t> footprint;
+   io.post([&]() { footprint.set_value(session->memory_footprint()); });
+   return footprint.get_future().get();
+}
+
+int main() {
+   int failures = 0;
+
+   auto expect_within_budget = [&](const char* state, std::size_t footprint) {
+      std::cout << state << ": " << footprint << " octets" << std::endl;
+      if (footprint > IDLE_SESSION_BUDGET) {
+         std::cerr << "FAIL: " << state << " exceeds the budget of "
+                   << IDLE_SESSION_BUDGET << " octets" << std::endl;
+         ++failures;
+      }
+   };
+
+   boost::asio::io_service io;
+   tcp::acceptor acceptor(io, tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+   tcp::socket socket(io);
+   tcp::socket router(io);
+   socket.connect(acceptor.local_endpoint());
+   acceptor.accept(router);
+
+   auto session = std::make_shared<session_type>(io, socket, socket);
+   std::size_t initial = session->memory_footprint();
+
+   session->set_lean_mode(true);
+   std::size_t lean = session->memory_footprint();
+
+   std::cout << "session object: " << sizeof(session_type) << " octets" << std::endl;
+   std::cout << "idle session: " << initial << " octets" << std::endl;
+
+   if (lean > initial) {
+      std::cerr << "FAIL: lean mode grew the session footprint" << std::endl;
+      ++failures;
+   }
+   expect_within_budget("idle lean session", lean);
+
+   // RawSocket handshake, then HELLO and WELCOME
+   boost::future<bool> started = session->start();
+   unsigned char handshake[4];
+   boost::asio::read(router, boost::asio::buffer(handshake));
+   const unsigned char handshake_reply[4] = { 0x7F, 0xF2, 0x00, 0x00 };
+   boost::asio::write(router, boost::asio::buffer(handshake_reply));
+
+   std::thread io_thread([&io]() { io.run(); });
+
+   if (!started.get()) {
+      std::cerr << "FAIL: RawSocket handshake" << std::endl;
+      return EXIT_FAILURE;
+   }
+
+   boost::future<uint64_t> joined = session->join("realm1");
+   read_message(router);
+   {
+      msgpack::sbuffer welcome;
+      msgpack::packer<msgpack::sbuffer> packer(welcome);
+
+      // [WELCOME, Session|id, Details|dict]
+      packer.pack_array(3);
+      packer.pack(static_cast<int>(autobahn::message_type::WELCOME));
+      packer.pack(1);
+      packer.pack_map(0);
+      write_message(router, welcome);
+   }
+   joined.get();
+
+   // A large RESULT passes through the receive buffer and a zone of its own, and
+   // the call had a timeout, which puts it into the call timeout wheel.
+   {
+      autobahn::wamp_call_options options;
+      options.set_timeout(std::chrono::seconds(60));
+      boost::future<autobahn::wamp_call_result> call = session->call("com.example.large", options);
+      uint64_t request_id = request_id_of(read_message(router));
+
+      msgpack::sbuffer result;
+      msgpack::packer<msgpack::sbuffer> packer(result);
+
+      // [RESULT, CALL.Request|id, Details|dict, YIELD.Arguments|list]
+      packer.pack_array(4);
+      packer.pack(static_cast<int>(autobahn::message_type::RESULT));
+      packer.pack(request_id);
+      packer.pack_map(0);
+      packer.pack_array(1);
+      packer.pack(std::string(LARGE_PAYLOAD_SIZE, 'x'));
+      write_message(router, result);
+
+      if (call.get().argument<std::string>(0).size() != LARGE_PAYLOAD_SIZE) {
+         std::cerr << "FAIL: large result truncated" << std::endl;
+         ++failures;
+      }
+   }
+   expect_within_budget("lean session after a large message", footprint_of(io, session));
+
+   // A call that is never answered drains from the wheel when it times out and
+   // the dealer has answered its cancellation.
+   {
+      autobahn::wamp_call_options options;
+      options.set_timeout(std::chrono::milliseconds(20));
+      boost::future<autobahn::wamp_call_result> call = session->call("com.example.slow", options);
+      read_message(router);
+
+      try {
+         call.get();
+         std::cerr << "FAIL: unanswered call did not time out" << std::endl;
+         ++failures;
+      } catch (const autobahn::timeout_error&) {
+      }
+
+      msgpack::sbuffer error;
+      msgpack::packer<msgpack::sbuffer> packer(error);
+
+      // [ERROR, CALL, CALL.Request|id, Details|dict, Error|uri]
+      packer.pack_array(5);
+      packer.pack(static_cast<int>(autobahn::message_type::ERROR));
+      packer.pack(static_cast<int>(autobahn::message_type::CALL));
+      packer.pack(request_id_of(read_message(router)));
+      packer.pack_map(0);
+      packer.pack(std::string("wamp.error.canceled"));
+      write_message(router, error);
+
+      // Once this call is answered, the ERROR before it has been processed.
+      boost::future<autobahn::wamp_call_result> ping = session->call("com.example.ping");
+      msgpack::sbuffer result;
+      msgpack::packer<msgpack::sbuffer> result_packer(result);
+
+      // [RESULT, CALL.Request|id, Details|dict]
+      result_packer.pack_array(3);
+      result_packer.pack(static_cast<int>(autobahn::message_type::RESULT));
+      result_packer.pack(request_id_of(read_message(router)));
+      result_packer.pack_map(0);
+      write_message(router, result);
+      ping.get();
+   }
+   expect_within_budget("lean session after a call timed out", footprint_of(io, session));
+
+   session->leave();
+   session->stop().get();
+   io_thread.join();
+
+   if (failures) {
+      return EXIT_FAILURE;
+   }
+
+   std::cout << "OK" << std::endl;
+   return EXIT_SUCCESS;
+}
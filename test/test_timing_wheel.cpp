@@ -0,0 +1,117 @@
+///////////////////////////////////////////////////////////////////////////////
+//
+//  Copyright (C) 2014 Tavendo GmbH
+//
+//  Licensed under the Apache License, Version 2.0 (the "License");
+//  you may not use this file except in compliance with the License.
+//  You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+//  Unless required by applicable law or agreed to in writing, software
+//  distributed under the License is distributed on an "AS IS" BASIS,
+//  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+//  See the License for the specific language governing permissions and
+//  limitations under the License.
+//
+///////////////////////////////////////////////////////////////////////////////
+
+// Checks that the call timeout wheel expires every entry at exactly its tick,
+// across the boundaries between its levels and past the range they cover, and
+// that cancelled entries never expire.
+
+#include <autobahn/autobahn.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+/// Advance @p wheel one tick at a time up to @p tick and record when each ID expired.
+static void advance_by_tick(autobahn::wamp_timing_wheel& wheel, uint64_t tick,
+      std::map<uint64_t, uint64_t>& expired_at)
+{
+   std::vector<uint64_t> expired;
+   while (wheel.now() < tick && !wheel.empty()) {
+      uint64_t now = wheel.now() + 1;
+      wheel.advance(now, expired);
+      for (uint64_t id : expired) {
+         expired_at[id] = now;
+      }
+      expired.clear();
+   }
+   wheel.advance(tick, expired);
+}
+
+int main() {
+   int failures = 0;
+
+   auto expect = [&](const std::string& name, bool condition) {
+      if (!condition) {
+         std::cerr << "FAIL: " << name << std::endl;
+         ++failures;
+      }
+   };
+
+   auto expect_expiries = [&](const char* name, uint64_t start, const std::vector<uint64_t>& expiries) {
+      autobahn::wamp_timing_wheel wheel;
+      std::vector<uint64_t> expired;
+      wheel.advance(start, expired);
+
+      for (std::size_t id = 0; id < expiries.size(); ++id) {
+         wheel.schedule(id, expiries[id]);
+      }
+
+      std::map<uint64_t, uint64_t> expired_at;
+      advance_by_tick(wheel, expiries.back(), expired_at);
+
+      expect(std::string(name) + ": wheel drained", wheel.empty());
+      for (std::size_t id = 0; id < expiries.size(); ++id) {
+         auto itr = expired_at.find(id);
+         expect(std::string(name) + ": expiry at " + std::to_string(expiries[id]),
+               itr != expired_at.end() && itr->second == expiries[id]);
+      }
+   };
+
+   const uint64_t level_range = uint64_t(1) << 32;
+
+   // Level 0 to 1, and level 1 to 2
+   expect_expiries("low levels", 0, { 1, 255, 256, 257, 511, 512, 65535, 65536, 65537 });
+
+   // Level 2 to 3
+   expect_expiries("level 3", 0xffff00, { 0xffffff, 0x1000000, 0x1000001, 0x10000ff, 0x1000100 });
+
+   // Beyond the range of the top level: the overflow list is spread out when the
+   // clock reaches 2^32, and its entries cascade down again from the top.
+   expect_expiries("overflow", level_range - 300, {
+         level_range - 1, level_range, level_range + 1, level_range + 255, level_range + 256,
+         level_range + 65536 });
+
+   // Cancelled entries do not expire, wherever they have cascaded to
+   {
+      autobahn::wamp_timing_wheel wheel;
+      wheel.schedule(1, 300);
+      wheel.schedule(2, 300);
+      wheel.schedule(3, 70000);
+      wheel.schedule(4, 70000);
+
+      expect("cancel before cascading", wheel.cancel(1, 300));
+      expect("cancel twice", !wheel.cancel(1, 300));
+      expect("cancel with other expiry", !wheel.cancel(2, 301));
+
+      std::map<uint64_t, uint64_t> expired_at;
+      advance_by_tick(wheel, 69999, expired_at);
+      expect("cancel after cascading", wheel.cancel(3, 70000));
+      expect("size after cancelling", wheel.size() == 1);
+
+      advance_by_tick(wheel, 70000, expired_at);
+      expect("cancelled entries did not expire", expired_at.count(1) == 0 && expired_at.count(3) == 0);
+      expect("other entries expired", expired_at[2] == 300 && expired_at[4] == 70000);
+      expect("cancel after expiry", !wheel.cancel(4, 70000));
+      expect("wheel drained after cancelling", wheel.empty());
+   }
+
+   return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}